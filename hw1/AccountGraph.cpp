@@ -0,0 +1,217 @@
+#include <algorithm>
+
+#include "AccountGraph.h"
+#include "BlockChain.h"
+
+//  Edges are first laid out by sender in chain order, then moved into rows
+//  by receiver. Senders are visited in increasing order, so every receiver
+//  row comes out sorted, with the repeated transfers of a pair next to each
+//  other where they are merged. Moving the merged edges back into rows by
+//  sender sorts those rows too. Both moves are counting sorts.
+
+//****************************************************************************//
+
+//Moves every edge v -> others[e] into row others[e] of the transposed arrays
+void transposeRows(const std::vector<unsigned int>& starts,
+    const std::vector<unsigned int>& others, const std::vector<unsigned long long>& values,
+    std::vector<unsigned int>& transposedStarts, std::vector<unsigned int>& transposedOthers,
+    std::vector<unsigned long long>& transposedValues)
+{
+    const unsigned int accounts = starts.size() - 1;
+    transposedStarts.assign(accounts + 1, 0);
+    for (const unsigned int other : others) {
+        transposedStarts[other + 1]++;
+    }
+    for (unsigned int v = 0; v < accounts; v++) {
+        transposedStarts[v + 1] += transposedStarts[v];
+    }
+    transposedOthers.resize(others.size());
+    transposedValues.resize(values.size());
+    std::vector<unsigned int> next(transposedStarts.begin(), transposedStarts.end() - 1);
+    for (unsigned int v = 0; v < accounts; v++) {
+        for (unsigned int edge = starts[v]; edge < starts[v + 1]; edge++) {
+            const unsigned int slot = next[others[edge]]++;
+            transposedOthers[slot] = v;
+            transposedValues[slot] = values[edge];
+        }
+    }
+}
+
+//****************************************************************************//
+
+//Merges the neighbouring edges of every row that lead to the same account
+void mergeRows(std::vector<unsigned int>& starts, std::vector<unsigned int>& others,
+    std::vector<unsigned long long>& values)
+{
+    const unsigned int accounts = starts.size() - 1;
+    unsigned int kept = 0;
+    unsigned int first = 0;
+    for (unsigned int v = 0; v < accounts; v++) {
+        const unsigned int last = starts[v + 1];
+        starts[v] = kept;
+        for (unsigned int edge = first; edge < last; edge++) {
+            if (kept > starts[v] && others[kept - 1] == others[edge]) {
+                values[kept - 1] += values[edge];
+            }
+            else {
+                others[kept] = others[edge];
+                values[kept] = values[edge];
+                kept++;
+            }
+        }
+        first = last;
+    }
+    starts[accounts] = kept;
+    others.resize(kept);
+    values.resize(kept);
+}
+
+//****************************************************************************//
+
+void AccountGraphBuild(AccountGraph& graph, const BlockChain& blockChain)
+{
+    const unsigned int accounts = InternTableSize(AccountNames());
+    std::vector<unsigned int> starts(accounts + 1, 0);
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next) {
+        starts[current->transaction.sender.id + 1]++;
+    }
+    for (unsigned int v = 0; v < accounts; v++) {
+        starts[v + 1] += starts[v];
+    }
+    std::vector<unsigned int> receivers(starts[accounts]);
+    std::vector<unsigned long long> values(starts[accounts]);
+    std::vector<unsigned int> next(starts.begin(), starts.end() - 1);
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next) {
+        const unsigned int slot = next[current->transaction.sender.id]++;
+        receivers[slot] = current->transaction.receiver.id;
+        values[slot] = current->transaction.value;
+    }
+    transposeRows(starts, receivers, values, graph.inStarts, graph.inSources, graph.inValues);
+    mergeRows(graph.inStarts, graph.inSources, graph.inValues);
+    transposeRows(graph.inStarts, graph.inSources, graph.inValues,
+        graph.outStarts, graph.outTargets, graph.outValues);
+}
+
+//****************************************************************************//
+
+int AccountGraphEdges(const AccountGraph& graph)
+{
+    return graph.outTargets.size();
+}
+
+//****************************************************************************//
+
+unsigned long long AccountGraphSent(const AccountGraph& graph, const AccountName sender,
+    const AccountName receiver)
+{
+    if (sender.id + 1 >= graph.outStarts.size()) {
+        return 0;
+    }
+    const auto first = graph.outTargets.begin() + graph.outStarts[sender.id];
+    const auto last = graph.outTargets.begin() + graph.outStarts[sender.id + 1];
+    const auto found = std::lower_bound(first, last, receiver.id);
+    if (found == last || *found != receiver.id) {
+        return 0;
+    }
+    return graph.outValues[found - graph.outTargets.begin()];
+}
+
+//****************************************************************************//
+
+long long AccountGraphNetFlow(const AccountGraph& graph, const AccountName account,
+    const AccountName other)
+{
+    return static_cast<long long>(AccountGraphSent(graph, other, account)) -
+        static_cast<long long>(AccountGraphSent(graph, account, other));
+}
+
+//****************************************************************************//
+
+std::vector<Counterparty> AccountGraphTopCounterparties(const AccountGraph& graph,
+    const AccountName account, const int count)
+{
+    std::vector<Counterparty> counterparties;
+    if (account.id + 1 >= graph.outStarts.size()) {
+        return counterparties;
+    }
+    //Both rows are sorted by account id, so they are merged in one pass
+    unsigned int out = graph.outStarts[account.id];
+    unsigned int in = graph.inStarts[account.id];
+    const unsigned int outEnd = graph.outStarts[account.id + 1];
+    const unsigned int inEnd = graph.inStarts[account.id + 1];
+    while (out < outEnd || in < inEnd) {
+        const bool isSent = out < outEnd &&
+            (in == inEnd || graph.outTargets[out] <= graph.inSources[in]);
+        const bool isReceived = in < inEnd &&
+            (out == outEnd || graph.inSources[in] <= graph.outTargets[out]);
+        Counterparty counterparty = {AccountName(), 0, 0};
+        if (isSent) {
+            counterparty.account.id = graph.outTargets[out];
+            counterparty.sent = graph.outValues[out++];
+        }
+        if (isReceived) {
+            counterparty.account.id = graph.inSources[in];
+            counterparty.received = graph.inValues[in++];
+        }
+        counterparties.push_back(counterparty);
+    }
+    const auto isBefore = [](const Counterparty& lhs, const Counterparty& rhs) {
+        const unsigned long long lhsTotal = lhs.sent + lhs.received;
+        const unsigned long long rhsTotal = rhs.sent + rhs.received;
+        return lhsTotal != rhsTotal ? lhsTotal > rhsTotal : lhs.account.id < rhs.account.id;
+    };
+    const size_t kept = std::min(counterparties.size(),
+        static_cast<size_t>(std::max(count, 0)));
+    std::partial_sort(counterparties.begin(), counterparties.begin() + kept,
+        counterparties.end(), isBefore);
+    counterparties.resize(kept);
+    return counterparties;
+}
+
+//****************************************************************************//
+
+std::vector<AccountName> AccountGraphFindCycle(const AccountGraph& graph)
+{
+    enum State : char { UNSEEN, ON_PATH, DONE };
+    const unsigned int accounts = graph.outStarts.empty() ? 0 : graph.outStarts.size() - 1;
+    std::vector<State> states(accounts, UNSEEN);
+    //Next edge to follow out of every account on the path
+    std::vector<unsigned int> positions(accounts);
+    std::vector<unsigned int> path;
+    for (unsigned int root = 0; root < accounts; root++) {
+        if (states[root] != UNSEEN) {
+            continue;
+        }
+        states[root] = ON_PATH;
+        positions[root] = graph.outStarts[root];
+        path.push_back(root);
+        while (!path.empty()) {
+            const unsigned int v = path.back();
+            if (positions[v] == graph.outStarts[v + 1]) {
+                states[v] = DONE;
+                path.pop_back();
+                continue;
+            }
+            const unsigned int w = graph.outTargets[positions[v]++];
+            if (states[w] == ON_PATH) {
+                std::vector<AccountName> cycle;
+                for (auto it = std::find(path.begin(), path.end(), w); it != path.end(); ++it) {
+                    AccountName account;
+                    account.id = *it;
+                    cycle.push_back(account);
+                }
+                return cycle;
+            }
+            if (states[w] == UNSEEN) {
+                states[w] = ON_PATH;
+                positions[w] = graph.outStarts[w];
+                path.push_back(w);
+            }
+        }
+    }
+    return std::vector<AccountName>();
+}
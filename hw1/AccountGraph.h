@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+
+#include "Transaction.h"
+
+struct BlockChain;
+
+
+/**
+*
+ * AccountGraph - The transfers of a BlockChain as a graph of accounts
+ *
+ * Every account is a vertex, addressed by its AccountName id, and every
+ * pair of accounts that transferred value is one edge holding the total of
+ * those transfers. Edges are stored in compressed sparse rows twice: once
+ * grouped by sender and once grouped by receiver, each row sorted by the id
+ * of the other account. Building the graph and every query below take time
+ * linear in the number of Blocks, edges and accounts.
+ *
+*/
+struct AccountGraph {
+
+      //Edges sent by account v are [outStarts[v], outStarts[v + 1]) of the out arrays
+      std::vector<unsigned int> outStarts;
+      std::vector<unsigned int> outTargets;
+      std::vector<unsigned long long> outValues;
+      //Edges received by account v are [inStarts[v], inStarts[v + 1]) of the in arrays
+      std::vector<unsigned int> inStarts;
+      std::vector<unsigned int> inSources;
+      std::vector<unsigned long long> inValues;
+};
+
+
+/**
+*
+ * Counterparty - An account together with what was sent to it and received from it
+ *
+*/
+struct Counterparty {
+
+      AccountName account;
+      unsigned long long sent;
+      unsigned long long received;
+};
+
+
+/**
+ * AccountGraphBuild - builds the graph of every transfer in a chain
+ *
+ * @param graph Graph to fill, its previous edges are dropped
+ * @param blockChain Head of the chain
+*/
+void AccountGraphBuild(AccountGraph& graph, const BlockChain& blockChain);
+
+
+/**
+ * AccountGraphEdges - returns the number of distinct sender and receiver pairs
+*/
+int AccountGraphEdges(const AccountGraph& graph);
+
+
+/**
+ * AccountGraphSent - returns the total value one account sent to another
+ *
+ * @param graph Graph to read
+ * @param sender Account the value left
+ * @param receiver Account the value reached
+*/
+unsigned long long AccountGraphSent(const AccountGraph& graph, AccountName sender,
+    AccountName receiver);
+
+
+/**
+ * AccountGraphNetFlow - returns what one account received from another minus
+ * what it sent to it
+ *
+ * @param graph Graph to read
+ * @param account Account whose side is taken
+ * @param other Account on the other side
+*/
+long long AccountGraphNetFlow(const AccountGraph& graph, AccountName account,
+    AccountName other);
+
+
+/**
+ * AccountGraphTopCounterparties - returns the accounts an account exchanged the most value with
+ *
+ * @param graph Graph to read
+ * @param account Account to look at
+ * @param count Number of accounts to return at most
+ *
+ * @return The accounts by decreasing sent plus received, ties by increasing AccountName id
+*/
+std::vector<Counterparty> AccountGraphTopCounterparties(const AccountGraph& graph,
+    AccountName account, int count);
+
+
+/**
+ * AccountGraphFindCycle - looks for value that flows back to where it came from
+ *
+ * @param graph Graph to search
+ *
+ * @return Accounts in transfer order, each sending to the next and the last one
+ * to the first, or an empty vector if there is no such cycle
+*/
+std::vector<AccountName> AccountGraphFindCycle(const AccountGraph& graph);
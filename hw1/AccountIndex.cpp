@@ -0,0 +1,66 @@
+#include "AccountIndex.h"
+
+//****************************************************************************//
+
+//Makes sure the table has a slot for the given account
+void reserveAccount(AccountIndex& index, const AccountName account)
+{
+    if (account.id >= index.balances.size()) {
+        index.balances.resize(account.id + 1, 0);
+        index.present.resize(account.id + 1, false);
+    }
+    index.present[account.id] = true;
+}
+
+//****************************************************************************//
+
+void AccountIndexClear(AccountIndex& index)
+{
+    index.balances.clear();
+    index.present.clear();
+}
+
+//****************************************************************************//
+
+void AccountIndexAdd(AccountIndex& index, const Transaction& transaction)
+{
+    reserveAccount(index, transaction.sender);
+    reserveAccount(index, transaction.receiver);
+    index.balances[transaction.sender.id] -= transaction.value;
+    index.balances[transaction.receiver.id] += transaction.value;
+}
+
+//****************************************************************************//
+
+void AccountIndexAdjust(AccountIndex& index, const Transaction& transaction,
+    const unsigned int oldValue)
+{
+    const unsigned int delta = transaction.value - oldValue;
+    index.balances[transaction.sender.id] -= delta;
+    index.balances[transaction.receiver.id] += delta;
+}
+
+//****************************************************************************//
+
+int AccountIndexBalance(const AccountIndex& index, const AccountName account)
+{
+    if (account.id >= index.balances.size()) {
+        return 0;
+    }
+    return index.balances[account.id];
+}
+
+//****************************************************************************//
+
+std::vector<AccountBalance> AccountIndexBalances(const AccountIndex& index)
+{
+    std::vector<AccountBalance> result;
+    for (unsigned int id = 0; id < index.balances.size(); id++) {
+        if (index.present[id]) {
+            AccountName account;
+            account.id = id;
+            result.push_back({account, index.balances[id]});
+        }
+    }
+    return result;
+}
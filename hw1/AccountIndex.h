@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vector>
+
+#include "Transaction.h"
+
+
+/**
+*
+ * AccountIndex - Running balance of every account that appears in a BlockChain
+ *
+ * Balances are kept in a table addressed by AccountName id, so reading one
+ * is a single array access once the name is resolved.
+ *
+*/
+struct AccountIndex {
+
+      std::vector<int> balances;
+      std::vector<bool> present;
+};
+
+
+/**
+*
+ * AccountBalance - An account together with its balance
+ *
+*/
+struct AccountBalance {
+
+      AccountName account;
+      int balance;
+};
+
+
+/**
+ * AccountIndexClear - forgets every account in the index
+ *
+ * @param index Index to clear
+*/
+void AccountIndexClear(AccountIndex& index);
+
+
+/**
+ * AccountIndexAdd - records a transaction in the index
+ *
+ * @param index Index to update
+ * @param transaction Transaction to record
+*/
+void AccountIndexAdd(AccountIndex& index, const Transaction& transaction);
+
+
+/**
+ * AccountIndexAdjust - records a change in the value of a transaction already in the index
+ *
+ * @param index Index to update
+ * @param transaction Transaction holding the new value
+ * @param oldValue Value the transaction was recorded with
+*/
+void AccountIndexAdjust(AccountIndex& index, const Transaction& transaction,
+    unsigned int oldValue);
+
+
+/**
+ * AccountIndexBalance - returns the balance of an account
+ *
+ * @param index Index to read
+ * @param account Account to look up
+ *
+ * @return Balance of the account, 0 if it never appeared
+*/
+int AccountIndexBalance(const AccountIndex& index, AccountName account);
+
+
+/**
+ * AccountIndexBalances - returns the balance of every account in the index
+ *
+ * @param index Index to read
+ *
+ * @return Every account that appeared in a recorded transaction, in AccountName id order
+*/
+std::vector<AccountBalance> AccountIndexBalances(const AccountIndex& index);
@@ -1,9 +1,26 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+
 #include "BlockChain.h"
+#include "AccountIndex.h"
+#include "LedgerBinary.h"
+#include "LedgerParser.h"
+#include "MappedFile.h"
+#include "MerkleTree.h"
+#include "Stats.h"
+#include "ThreadPool.h"
+#include "TimeIndex.h"
+#include "TransactionLog.h"
 
 //****************************************************************************//
 
 void insertData(BlockChain& block, const Transaction& transaction,
-    const string& timestamp)
+    const Timestamp timestamp)
 {
     block.transaction = transaction;
     block.timestamp = timestamp;
@@ -12,10 +29,63 @@ void insertData(BlockChain& block, const Transaction& transaction,
 
 //****************************************************************************//
 
+//Returns the AccountIndex attached to the Ledger owning the block, if any
+AccountIndex* attachedIndex(const BlockChain& block)
+{
+    return block.ledger != nullptr ? block.ledger->index : nullptr;
+}
+
+//****************************************************************************//
+
+//Tells whether the block is the head of the chain of the Ledger owning it
+bool isLedgerHead(const BlockChain& block)
+{
+    return block.ledger != nullptr && &block == &LedgerHead(*block.ledger);
+}
+
+//****************************************************************************//
+
+//Records the extent of a chain just loaded into the Ledger
+void setLoadedExtent(Ledger& ledger, BlockChain* tail, const int count)
+{
+    ledger.tail = tail != nullptr ? tail : &LedgerHead(ledger);
+    ledger.count = count;
+}
+
+//****************************************************************************//
+
+//Rebuilds the MerkleTree and the TimeIndex attached to the Ledger owning the block, if any
+void rebuildAttached(const BlockChain& block)
+{
+    if (block.ledger == nullptr) {
+        return;
+    }
+    if (block.ledger->merkle != nullptr) {
+        MerkleTreeBuild(*block.ledger->merkle, LedgerHead(*block.ledger));
+    }
+    if (block.ledger->times != nullptr) {
+        TimeIndexBuild(*block.ledger->times, LedgerHead(*block.ledger));
+    }
+}
+
+//****************************************************************************//
+
+//Blocks of a chain owned by a Ledger are taken from it, others from the heap
+BlockChain* allocateBlock(const BlockChain& neighbour)
+{
+    if (neighbour.ledger != nullptr) {
+        return LedgerNewBlock(*neighbour.ledger);
+    }
+    return new BlockChain();
+}
+
+//****************************************************************************//
+
 void newBlockHead(BlockChain& head, const Transaction& transaction,
-    const string& timestamp)
+    const Timestamp timestamp)
 {
-    auto* newBlock = new BlockChain();
+    BlockChain* newBlock = allocateBlock(head);
+    //The old head's data moves down as it is
     *newBlock = head;
     insertData(head, transaction, timestamp);
     head.next = newBlock;
@@ -24,9 +94,9 @@ void newBlockHead(BlockChain& head, const Transaction& transaction,
 //****************************************************************************//
 
 void newBlockTail(BlockChain& tail, const Transaction& transaction,
-    const string& timestamp)
+    const Timestamp timestamp)
 {
-    auto* newBlock = new BlockChain();
+    BlockChain* newBlock = allocateBlock(tail);
     insertData(*newBlock, transaction, timestamp);
     tail.next = newBlock;
 }
@@ -35,7 +105,8 @@ void newBlockTail(BlockChain& tail, const Transaction& transaction,
 
 void BlockChain::deleteBlockChain(const BlockChain* head)
 {
-    while(head) {
+    //Blocks owned by a Ledger are released in bulk together with it
+    while(head && head->ledger == nullptr) {
         const BlockChain* toDelete = head;
         head = head->next;
         delete toDelete;
@@ -46,9 +117,12 @@ void BlockChain::deleteBlockChain(const BlockChain* head)
 
 int BlockChainGetSize(const BlockChain& blockChain)
 {
+    if (isLedgerHead(blockChain)) {
+        return LedgerSize(*blockChain.ledger);
+    }
     int size = 0;
     for (const BlockChain* current = &blockChain;
-        current != nullptr && !current->timestamp.empty();
+        current != nullptr && BlockChainIsOccupied(*current);
         current = current->next){
         size++;
     }
@@ -59,18 +133,26 @@ int BlockChainGetSize(const BlockChain& blockChain)
 
 int BlockChainPersonalBalance(const BlockChain& blockChain, const string& name)
 {
-    if (!BlockChainGetSize(blockChain)) {
+    if (!BlockChainIsOccupied(blockChain)) {
         std::cerr << "BlockChain is EMPTY! /Balance" << std::endl;
         return 0;
     }
+    AccountName account;
+    if (!InternTableFind(AccountNames(), name, account.id)) {
+        return 0;
+    }
+    const AccountIndex* index = attachedIndex(blockChain);
+    if (index != nullptr && &blockChain == &LedgerHead(*blockChain.ledger)) {
+        return AccountIndexBalance(*index, account);
+    }
     int balance = 0;
     for (const BlockChain* current = &blockChain;
-        current != nullptr && !current->timestamp.empty();
+        current != nullptr && BlockChainIsOccupied(*current);
         current = current->next){
-        if (current->transaction.receiver == name){
+        if (current->transaction.receiver == account){
             balance += current->transaction.value;
         }
-        if (current->transaction.sender == name){
+        if (current->transaction.sender == account){
             balance -= current->transaction.value;
         }
     }
@@ -82,15 +164,61 @@ int BlockChainPersonalBalance(const BlockChain& blockChain, const string& name)
 void BlockChainAppendTransaction(
         BlockChain& blockChain,
         const Transaction& transaction,
-        const string& timestamp
+        const Timestamp timestamp
 )
 {
-    if (blockChain.timestamp.empty()) {
+    Ledger* ledger = blockChain.ledger;
+    if (!BlockChainIsOccupied(blockChain)) {
         insertData(blockChain, transaction, timestamp);
     }
     else{
         newBlockHead(blockChain, transaction, timestamp);
+        if (ledger != nullptr && ledger->tail == &blockChain) {
+            ledger->tail = blockChain.next;
+        }
+    }
+    if (ledger != nullptr) {
+        ledger->count++;
+    }
+    AccountIndex* index = attachedIndex(blockChain);
+    if (index != nullptr) {
+        AccountIndexAdd(*index, transaction);
+    }
+    //Appending at the head extends the digest and the time index, anywhere
+    //else reshuffles them
+    if (ledger != nullptr && !isLedgerHead(blockChain)) {
+        rebuildAttached(blockChain);
+    }
+    else if (ledger != nullptr) {
+        if (ledger->merkle != nullptr) {
+            MerkleTreeAppend(*ledger->merkle, TransactionHashedMessage(transaction));
+        }
+        if (ledger->times != nullptr) {
+            TimeIndexAppend(*ledger->times, blockChain);
+        }
     }
+    if (ledger != nullptr && ledger->log != nullptr && isLedgerHead(blockChain)) {
+        if (!TransactionLogAppend(*ledger->log, transaction, timestamp.text())) {
+            std::cerr << "Transaction log commit FAILED! /Append" << std::endl;
+        }
+    }
+}
+
+//****************************************************************************//
+
+std::vector<AccountBalance> BlockChainAllBalances(const BlockChain& blockChain)
+{
+    const AccountIndex* index = attachedIndex(blockChain);
+    if (index != nullptr && &blockChain == &LedgerHead(*blockChain.ledger)) {
+        return AccountIndexBalances(*index);
+    }
+    AccountIndex balances;
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next){
+        AccountIndexAdd(balances, current->transaction);
+    }
+    return AccountIndexBalances(balances);
 }
 
 //****************************************************************************//
@@ -132,18 +260,348 @@ BlockChain BlockChainLoad(ifstream& file)
     return blockChain;
 }
 
+//****************************************************************************//
+
+BlockChain& BlockChainLoad(ifstream& file, Ledger& ledger)
+{
+    Transaction transaction;
+    string timestamp;
+    LedgerClear(ledger);
+    BlockChain& blockChain = LedgerHead(ledger);
+    BlockChain* tail = &blockChain;
+    int count = 0;
+
+    while (file  >> transaction.sender >> transaction.receiver
+            >> transaction.value >> timestamp) {
+        if (ledger.index != nullptr) {
+            AccountIndexAdd(*ledger.index, transaction);
+        }
+        if (count == 0) {
+            insertData(blockChain, transaction, timestamp);
+        }
+        else {
+            newBlockTail(*tail, transaction, timestamp);
+            tail = tail->next;
+        }
+        count++;
+    }
+    setLoadedExtent(ledger, tail, count);
+    rebuildAttached(blockChain);
+    return blockChain;
+}
+
+//****************************************************************************//
+
+BlockChain* BlockChainLoadMapped(const string& path, Ledger& ledger)
+{
+    MappedFile file;
+    if (!MappedFileOpen(file, path)) {
+        return nullptr;
+    }
+    LedgerClear(ledger);
+    BlockChain& blockChain = LedgerHead(ledger);
+    BlockChain* tail = nullptr;
+    LedgerScanner scanner = {file.data, file.data + file.size};
+    LedgerRecord record;
+    int count = 0;
+
+    while (LedgerScannerNext(scanner, record)) {
+        BlockChain* block = tail == nullptr ? &blockChain : LedgerNewBlock(ledger);
+        block->transaction.value = record.value;
+        block->transaction.sender = AccountName(record.sender);
+        block->transaction.receiver = AccountName(record.receiver);
+        block->timestamp = Timestamp(record.timestamp);
+        if (tail != nullptr) {
+            tail->next = block;
+        }
+        tail = block;
+        count++;
+        if (ledger.index != nullptr) {
+            AccountIndexAdd(*ledger.index, block->transaction);
+        }
+    }
+    setLoadedExtent(ledger, tail, count);
+    rebuildAttached(blockChain);
+    return &blockChain;
+}
+
+//****************************************************************************//
+
+//A part of the source file, parsed on its own thread into a sub-chain
+struct LoadPart {
+    LedgerScanner scanner;
+    Ledger blocks;
+    BlockChain* tail = nullptr;
+    int count = 0;
+    bool clean = true;
+};
+
+//****************************************************************************//
+
+//Most names and timestamps repeat, so look them up locally before locking the shared table
+template <typename Interned>
+Interned internCached(std::unordered_map<std::string_view, Interned>& cache,
+    const std::string_view value)
+{
+    const auto found = cache.find(value);
+    if (found != cache.end()) {
+        return found->second;
+    }
+    const Interned interned(value);
+    cache.emplace(value, interned);
+    return interned;
+}
+
+//****************************************************************************//
+
+void loadPart(LoadPart& part, Ledger& owner)
+{
+    std::unordered_map<std::string_view, AccountName> names;
+    std::unordered_map<std::string_view, Timestamp> timestamps;
+    LedgerRecord record;
+    while (!LedgerScannerAtEnd(part.scanner)) {
+        if (!LedgerScannerNext(part.scanner, record)) {
+            part.clean = false;
+            return;
+        }
+        BlockChain* block = part.tail == nullptr ?
+            &LedgerHead(part.blocks) : LedgerNewBlock(part.blocks);
+        block->ledger = &owner;
+        block->transaction.value = record.value;
+        block->transaction.sender = internCached(names, record.sender);
+        block->transaction.receiver = internCached(names, record.receiver);
+        block->timestamp = internCached(timestamps, record.timestamp);
+        if (part.tail != nullptr) {
+            part.tail->next = block;
+        }
+        part.tail = block;
+        part.count++;
+    }
+}
+
+//****************************************************************************//
+
+BlockChain* BlockChainLoadParallel(const string& path, Ledger& ledger,
+    const int threads)
+{
+    MappedFile file;
+    if (threads <= 1 || !MappedFileOpen(file, path)) {
+        return BlockChainLoadMapped(path, ledger);
+    }
+    const char* const end = file.data + file.size;
+    std::vector<LoadPart> parts(threads);
+    const char* start = file.data;
+    for (int i = 0; i < threads; i++) {
+        const char* stop = end;
+        if (i + 1 < threads) {
+            stop = std::max(start, file.data + file.size / threads * (i + 1));
+            stop = std::find(stop, end, '\n');
+            stop = stop == end ? end : stop + 1;
+        }
+        parts[i].scanner = {start, stop};
+        start = stop;
+    }
+
+    std::vector<std::thread> workers;
+    for (LoadPart& part : parts) {
+        workers.emplace_back(loadPart, std::ref(part), std::ref(ledger));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (int i = 0; i + 1 < threads; i++) {
+        if (!parts[i].clean) {
+            return BlockChainLoadMapped(path, ledger);
+        }
+    }
+
+    LedgerClear(ledger);
+    BlockChain& blockChain = LedgerHead(ledger);
+    BlockChain* tail = nullptr;
+    int count = 0;
+    for (LoadPart& part : parts) {
+        if (part.tail == nullptr) {
+            continue;
+        }
+        BlockChain& partHead = LedgerHead(part.blocks);
+        if (tail == nullptr) {
+            blockChain = partHead;
+            tail = part.tail == &partHead ? &blockChain : part.tail;
+        }
+        else {
+            tail->next = &partHead;
+            tail = part.tail;
+        }
+        LedgerAdopt(ledger, part.blocks);
+        count += part.count;
+    }
+    setLoadedExtent(ledger, tail, count);
+    if (ledger.index != nullptr) {
+        LedgerAttachIndex(ledger, ledger.index);
+    }
+    rebuildAttached(blockChain);
+    return &blockChain;
+}
+
+//****************************************************************************//
+
+//Writes a value into the buffer byte for byte
+template <typename T>
+void writeRaw(OutputBuffer& buffer, const T& value)
+{
+    OutputBufferWrite(buffer,
+        std::string_view(reinterpret_cast<const char*>(&value), sizeof(value)));
+}
+
+//****************************************************************************//
+
+bool BlockChainSaveBinary(const BlockChain& blockChain, ofstream& file)
+{
+    //Dictionary positions of the names, by AccountName id, in order of first use
+    static const uint32_t UNSEEN = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> positions(InternTableSize(AccountNames()), UNSEEN);
+    std::vector<AccountName> names;
+    LedgerBinaryHeader header = {};
+    std::memcpy(header.magic, LEDGER_BINARY_MAGIC, sizeof(header.magic));
+    header.version = LEDGER_BINARY_VERSION;
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next) {
+        for (AccountName name : {current->transaction.sender, current->transaction.receiver}) {
+            if (positions[name.id] == UNSEEN) {
+                positions[name.id] = names.size();
+                names.push_back(name);
+                header.namesSize += name.name().size();
+            }
+        }
+        header.blockCount++;
+        header.timestampsSize += current->timestamp.text().size();
+    }
+    header.nameCount = names.size();
+
+    OutputBuffer buffer(file);
+    writeRaw(buffer, header);
+    for (AccountName name : names) {
+        writeRaw(buffer, static_cast<uint32_t>(name.name().size()));
+    }
+    for (AccountName name : names) {
+        OutputBufferWrite(buffer, name.name());
+    }
+    OutputBufferWrite(buffer, std::string_view("\0\0\0", LedgerBinaryPadding(header.namesSize)));
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next) {
+        const LedgerBinaryRecord record = {
+            positions[current->transaction.sender.id],
+            positions[current->transaction.receiver.id],
+            current->transaction.value,
+            static_cast<uint32_t>(current->timestamp.text().size())
+        };
+        writeRaw(buffer, record);
+    }
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next) {
+        OutputBufferWrite(buffer, current->timestamp.text());
+    }
+    OutputBufferFlush(buffer);
+    return file.good();
+}
+
+//****************************************************************************//
+
+bool BlockChainIsBinary(const string& path)
+{
+    //The magic alone could start a text ledger, so the sections must add up to the file too
+    LedgerBinaryHeader header;
+    ifstream file(path, std::ios::binary | std::ios::ate);
+    const std::streamoff size = file.tellg();
+    return file && file.seekg(0).read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+        LedgerBinaryCheckHeader(header, uint64_t(size));
+}
+
+//****************************************************************************//
+
+BlockChain* BlockChainLoadBinary(const string& path, Ledger& ledger)
+{
+    MappedFile file;
+    if (!MappedFileOpen(file, path)) {
+        return nullptr;
+    }
+    return BlockChainLoadBinary(file.data, file.size, ledger);
+}
+
+//****************************************************************************//
+
+BlockChain* BlockChainLoadBinary(const char* data, const size_t size, Ledger& ledger)
+{
+    LedgerBinaryView view;
+    if (!LedgerBinaryOpen(data, size, view)) {
+        return nullptr;
+    }
+    //Every name is interned once, records only pick them by position
+    std::vector<AccountName> names;
+    names.reserve(view.header.nameCount);
+    const char* name = view.names;
+    for (uint32_t i = 0; i < view.header.nameCount; i++) {
+        const uint32_t size = LedgerBinaryNameSize(view, i);
+        names.emplace_back(std::string_view(name, size));
+        name += size;
+    }
+
+    LedgerClear(ledger);
+    BlockChain& blockChain = LedgerHead(ledger);
+    BlockChain* tail = nullptr;
+    const char* timestamp = view.timestamps;
+    const char* const timestampsEnd = view.timestamps + view.header.timestampsSize;
+    std::unordered_map<std::string_view, Timestamp> timestamps;
+    int count = 0;
+    for (uint64_t i = 0; i < view.header.blockCount; i++) {
+        const LedgerBinaryRecord record = LedgerBinaryRecordAt(view, i);
+        //An empty timestamp would end the chain early, so it is as corrupt as a bad name
+        if (record.sender >= names.size() || record.receiver >= names.size() ||
+            record.timestampSize == 0 ||
+            record.timestampSize > static_cast<size_t>(timestampsEnd - timestamp)) {
+            LedgerClear(ledger);
+            return nullptr;
+        }
+        BlockChain* block = tail == nullptr ? &blockChain : LedgerNewBlock(ledger);
+        block->transaction.value = record.value;
+        block->transaction.sender = names[record.sender];
+        block->transaction.receiver = names[record.receiver];
+        block->timestamp = internCached(timestamps,
+            std::string_view(timestamp, record.timestampSize));
+        timestamp += record.timestampSize;
+        if (tail != nullptr) {
+            tail->next = block;
+        }
+        tail = block;
+        count++;
+        if (ledger.index != nullptr) {
+            AccountIndexAdd(*ledger.index, block->transaction);
+        }
+    }
+    setLoadedExtent(ledger, tail, count);
+    rebuildAttached(blockChain);
+    return &blockChain;
+}
+
 //****************************************************************************//
 //TO CHECK: We can assume that the input is correct 
 void BlockChainDump(const BlockChain& blockChain, ofstream& file)
 {
+    OutputBuffer buffer(file);
     int rank = 1;
-    file << "BlockChain Info:" << std::endl;
+    OutputBufferWrite(buffer, "BlockChain Info:\n");
     for (const BlockChain* current = &blockChain;
-        current != nullptr && !current->timestamp.empty();
+        current != nullptr && BlockChainIsOccupied(*current);
         current = current->next) {
-        file << rank << "." << std::endl;
-        TransactionDumpInfo(current->transaction, file);
-        file << "Transaction timestamp: " << current->timestamp << std::endl;
+        OutputBufferWriteNumber(buffer, rank);
+        OutputBufferWrite(buffer, ".\n");
+        TransactionDumpInfo(current->transaction, buffer);
+        OutputBufferWrite(buffer, "Transaction timestamp: ");
+        OutputBufferWrite(buffer, current->timestamp.text());
+        OutputBufferWrite(buffer, "\n");
         rank++;
     }
 }
@@ -152,70 +610,315 @@ void BlockChainDump(const BlockChain& blockChain, ofstream& file)
 //TO CHECK: We can assume that the input is correct 
 void BlockChainDumpHashed(const BlockChain& blockChain, ofstream& file)
 {
-    if (BlockChainGetSize(blockChain) == 0){
+    if (!BlockChainIsOccupied(blockChain)) {
         std::cerr << "BlockChain is EMPTY! /Hushed" << std::endl;
     }
+    OutputBuffer buffer(file);
     const BlockChain* current = &blockChain;
-    while(!current->timestamp.empty()) {
-        file << TransactionHashedMessage(current->transaction);
+    while(BlockChainIsOccupied(*current)) {
+        OutputBufferWrite(buffer, TransactionHashedMessage(current->transaction));
         if (current->next == nullptr) break;
-        file << std::endl;
+        OutputBufferWrite(buffer, "\n");
         current = current->next;
     }
 }
 
 //****************************************************************************//
 
-//Helper function for the next BlockChainVrifyFile function
-int CountHashedMessages(std::ifstream& file) {
-    //Saves the current cursor position (maybe the cursor isn't on the begining)
-    const std::streampos currentPosition = file.tellg();
-    int hashedCount = 0;
-    string hashedMessage;
-    //Reading and counting the lines until eof reached
-    while (std::getline(file, hashedMessage)) {
-        hashedCount++;
+//Returns the TimeIndex of the chain headed by the block, nullptr if it has none or it went
+//stale. Queries only read it, so that several may run at once; rebuilding is up to the owner
+const TimeIndex* currentTimes(const BlockChain& blockChain)
+{
+    if (!isLedgerHead(blockChain) || blockChain.ledger->times == nullptr ||
+        blockChain.ledger->times->isStale) {
+        return nullptr;
+    }
+    return blockChain.ledger->times;
+}
+
+//****************************************************************************//
+
+//Collects the ranks and Blocks in [from, to), from the TimeIndex when there is one
+std::vector<std::pair<int, const BlockChain*>> windowBlocks(
+    const BlockChain& blockChain, const int from, const int to)
+{
+    std::vector<std::pair<int, const BlockChain*>> blocks;
+    const TimeIndex* times = currentTimes(blockChain);
+    if (times != nullptr) {
+        for (const int rank : TimeIndexWindow(*times, from, to)) {
+            blocks.emplace_back(rank, TimeIndexBlockOfRank(*times, rank));
+        }
+        StatsAddBlocks(blocks.size());
+        return blocks;
+    }
+    int rank = 1;
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next, rank++) {
+        const int time = TimeIndexParse(current->timestamp.text());
+        if (time != TimeIndex::INVALID_TIME && from <= time && time < to) {
+            blocks.emplace_back(rank, current);
+        }
+    }
+    StatsAddBlocks(rank - 1);
+    return blocks;
+}
+
+//****************************************************************************//
+
+int BlockChainPersonalBalanceWindow(const BlockChain& blockChain, const string& name,
+    const string& from, const string& to)
+{
+    AccountName account;
+    if (!InternTableFind(AccountNames(), name, account.id)) {
+        return 0;
+    }
+    const int fromTime = TimeIndexParse(from);
+    const int toTime = TimeIndexParse(to);
+    if (fromTime == TimeIndex::INVALID_TIME || toTime == TimeIndex::INVALID_TIME) {
+        return 0;
+    }
+    const TimeIndex* times = currentTimes(blockChain);
+    if (times != nullptr) {
+        return TimeIndexWindowBalance(*times, account, fromTime, toTime);
+    }
+    int balance = 0;
+    for (const std::pair<int, const BlockChain*>& block :
+        windowBlocks(blockChain, fromTime, toTime)) {
+        if (block.second->transaction.receiver == account){
+            balance += block.second->transaction.value;
+        }
+        if (block.second->transaction.sender == account){
+            balance -= block.second->transaction.value;
+        }
+    }
+    return balance;
+}
+
+//****************************************************************************//
+
+void BlockChainDumpWindow(const BlockChain& blockChain, const string& from,
+    const string& to, ofstream& file)
+{
+    OutputBuffer buffer(file);
+    OutputBufferWrite(buffer, "BlockChain Info:\n");
+    for (const std::pair<int, const BlockChain*>& block : windowBlocks(blockChain,
+        TimeIndexParse(from), TimeIndexParse(to))) {
+        OutputBufferWriteNumber(buffer, block.first);
+        OutputBufferWrite(buffer, ".\n");
+        TransactionDumpInfo(block.second->transaction, buffer);
+        OutputBufferWrite(buffer, "Transaction timestamp: ");
+        OutputBufferWrite(buffer, block.second->timestamp.text());
+        OutputBufferWrite(buffer, "\n");
+    }
+}
+
+//****************************************************************************//
+
+void BlockChainDumpHashedWindow(const BlockChain& blockChain, const string& from,
+    const string& to, ofstream& file)
+{
+    OutputBuffer buffer(file);
+    const std::vector<std::pair<int, const BlockChain*>> blocks =
+        windowBlocks(blockChain, TimeIndexParse(from), TimeIndexParse(to));
+    for (size_t i = 0; i < blocks.size(); i++) {
+        if (i > 0) {
+            OutputBufferWrite(buffer, "\n");
+        }
+        OutputBufferWrite(buffer, TransactionHashedMessage(blocks[i].second->transaction));
     }
-    //Clears the stream eof flag for this file
-    file.clear();
-    //Moving the cursor to the start position
-    file.seekg(currentPosition, std::ios::beg);
-    return hashedCount;
 }
 
 //****************************************************************************//
 //TO CHECK: We can assume that the input is correct 
-bool BlockChainVerifyFile(const BlockChain& blockChain, std::ifstream& file)
+bool BlockChainVerifyFile(const BlockChain& blockChain, std::ifstream& file,
+    int& mismatch)
 {
-    if(BlockChainGetSize(blockChain) == 0){
+    mismatch = 0;
+    if (!BlockChainIsOccupied(blockChain)) {
         std::cerr << "BlockChain is EMPTY! /Compress" << std::endl;
         return false;
     }
-    const int blocksCount = BlockChainGetSize(blockChain);
-    const int hashedCount = CountHashedMessages(file);
-    if (blocksCount != hashedCount){
-        return false;
-    }
-    if (blocksCount == 0 && hashedCount == 0){
-        return true;
-    } 
-
+    //Lines are compared as they are read, a missing or an extra line is a mismatch too
     string hashedMessage;
-    for (const BlockChain* current = &blockChain; current != nullptr;
-            current = current->next){
-        getline(file, hashedMessage);
-        if (hashedMessage != TransactionHashedMessage(current->transaction)) {
+    int rank = 1;
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next, rank++) {
+        if (!getline(file, hashedMessage) ||
+            hashedMessage != TransactionHashedMessage(current->transaction)) {
+            mismatch = rank;
             return false;
         }
     }
+    if (getline(file, hashedMessage)) {
+        mismatch = rank;
+        return false;
+    }
     return true;
 }
 
 //****************************************************************************//
 
+bool BlockChainVerifyFile(const BlockChain& blockChain, std::ifstream& file)
+{
+    int mismatch;
+    return BlockChainVerifyFile(blockChain, file, mismatch);
+}
+
+//****************************************************************************//
+
+//Blocks hashed by a single task of the parallel pipelines
+static const size_t HASH_BATCH_SIZE = 4096;
+
+//Batches in flight per thread, which bounds the memory held by the pipelines
+static const size_t BATCHES_PER_THREAD = 4;
+
+//Collects up to HASH_BATCH_SIZE occupied Blocks starting at current, and advances it
+std::vector<const BlockChain*> nextHashBatch(const BlockChain*& current)
+{
+    std::vector<const BlockChain*> batch;
+    while (current != nullptr && BlockChainIsOccupied(*current) &&
+        batch.size() < HASH_BATCH_SIZE) {
+        batch.push_back(current);
+        current = current->next;
+    }
+    if (current != nullptr && !BlockChainIsOccupied(*current)) {
+        current = nullptr;
+    }
+    return batch;
+}
+
+//****************************************************************************//
+
+void BlockChainDumpHashedParallel(const BlockChain& blockChain, ofstream& file,
+    const int threads)
+{
+    if (threads <= 1) {
+        BlockChainDumpHashed(blockChain, file);
+        return;
+    }
+    if (!BlockChainIsOccupied(blockChain)) {
+        std::cerr << "BlockChain is EMPTY! /Hushed" << std::endl;
+        return;
+    }
+    ThreadPool pool(threads);
+    OutputBuffer buffer(file);
+    std::deque<std::future<string>> pending;
+    const BlockChain* current = &blockChain;
+    while (current != nullptr || !pending.empty()) {
+        while (current != nullptr && pending.size() < threads * BATCHES_PER_THREAD) {
+            pending.push_back(ThreadPoolAsync(pool,
+                [batch = nextHashBatch(current)]() {
+                    string text;
+                    for (const BlockChain* block : batch) {
+                        text += TransactionHashedMessage(block->transaction);
+                        //Same separators as BlockChainDumpHashed
+                        if (block->next != nullptr) {
+                            text += '\n';
+                        }
+                    }
+                    return text;
+                }));
+        }
+        OutputBufferWrite(buffer, pending.front().get());
+        pending.pop_front();
+    }
+}
+
+//****************************************************************************//
+
+//Lowers the shared first mismatching rank to the given one if it is smaller
+void lowerMismatch(std::atomic<int>& first, const int rank)
+{
+    int current = first.load();
+    while (rank < current && !first.compare_exchange_weak(current, rank)) {
+    }
+}
+
+//****************************************************************************//
+
+//Reads lines until all of them are filled or the file ends, returns how many were read
+int readLines(std::ifstream& file, std::vector<string>& lines)
+{
+    StatsIoScope io;
+    int read = 0;
+    while (read < static_cast<int>(lines.size()) && getline(file, lines[read])) {
+        read++;
+    }
+    return read;
+}
+
+//****************************************************************************//
+
+bool BlockChainVerifyFileParallel(const BlockChain& blockChain,
+    std::ifstream& file, const int threads, int& mismatch)
+{
+    if (threads <= 1) {
+        return BlockChainVerifyFile(blockChain, file, mismatch);
+    }
+    mismatch = 0;
+    if (!BlockChainIsOccupied(blockChain)) {
+        std::cerr << "BlockChain is EMPTY! /Compress" << std::endl;
+        return false;
+    }
+    static const int NO_MISMATCH = std::numeric_limits<int>::max();
+    ThreadPool pool(threads);
+    std::atomic<int> first(NO_MISMATCH);
+    std::deque<std::future<void>> pending;
+    const BlockChain* current = &blockChain;
+    int rank = 1;
+    while (first == NO_MISMATCH && current != nullptr) {
+        std::vector<const BlockChain*> blocks = nextHashBatch(current);
+        const int count = blocks.size();
+        std::vector<string> lines(count);
+        const int read = readLines(file, lines);
+        if (read < count) {
+            lowerMismatch(first, rank + read);
+        }
+        //A worker gives up once an earlier Block is known to mismatch
+        pending.push_back(ThreadPoolAsync(pool,
+            [blocks = std::move(blocks), lines = std::move(lines), rank, &first]() {
+                for (int i = 0; i < static_cast<int>(blocks.size()) && rank + i < first; i++) {
+                    if (lines[i] != TransactionHashedMessage(blocks[i]->transaction)) {
+                        lowerMismatch(first, rank + i);
+                    }
+                }
+            }));
+        rank += count;
+        if (pending.size() == threads * BATCHES_PER_THREAD) {
+            pending.front().get();
+            pending.pop_front();
+        }
+    }
+    for (std::future<void>& task : pending) {
+        task.get();
+    }
+    string extraLine;
+    if (first == NO_MISMATCH && getline(file, extraLine)) {
+        lowerMismatch(first, rank);
+    }
+    if (first == NO_MISMATCH) {
+        return true;
+    }
+    mismatch = first;
+    return false;
+}
+
+//****************************************************************************//
+
+bool BlockChainVerifyFileParallel(const BlockChain& blockChain,
+    std::ifstream& file, const int threads)
+{
+    int mismatch;
+    return BlockChainVerifyFileParallel(blockChain, file, threads, mismatch);
+}
+
+//****************************************************************************//
+
 void BlockChainCompress(BlockChain& blockChain)
 {
-    if(BlockChainGetSize(blockChain) == 0){
+    if(!BlockChainIsOccupied(blockChain)){
         std::cerr << "BlockChain is EMPTY! /Compress" << std::endl;
         return;
     }
@@ -227,28 +930,214 @@ void BlockChainCompress(BlockChain& blockChain)
             current->transaction.value += current->next->transaction.value;
             const BlockChain* tempNext = current->next;
             current->next = current->next->next;
-            delete tempNext;
+            if (tempNext->ledger == nullptr) {
+                delete tempNext;
+            }
+            else {
+                tempNext->ledger->count--;
+                if (tempNext->ledger->tail == tempNext) {
+                    tempNext->ledger->tail = current;
+                }
+            }
             if (current->next == nullptr){
                 break;
             } 
         }
     }
+    rebuildAttached(blockChain);
 }
 
 //****************************************************************************//
 
-//TO CHECK: We can assume that the input is correct 
-void BlockChainTransform(BlockChain& blockChain, updateFunction function)
+//A stretch of the chain compressed on its own thread, from first up to (excluding) end
+struct CompressSegment {
+    BlockChain* first;
+    const BlockChain* end;
+    BlockChain* last = nullptr;
+    int removed = 0;
+};
+
+//****************************************************************************//
+
+//Merges the runs inside the segment, leaving the last kept Block linked to end
+void compressSegment(CompressSegment& segment)
 {
-    if(BlockChainGetSize(blockChain) == 0){
-        std::cerr << "BlockChain is EMPTY! /Transform" << std::endl;
+    BlockChain* current = segment.first;
+    while (current->next != segment.end) {
+        BlockChain* next = current->next;
+        if (current->transaction.sender == next->transaction.sender &&
+            current->transaction.receiver == next->transaction.receiver) {
+            current->transaction.value += next->transaction.value;
+            current->next = next->next;
+            segment.removed++;
+        }
+        else {
+            current = next;
+        }
+    }
+    segment.last = current;
+}
+
+//****************************************************************************//
+
+void BlockChainCompressParallel(BlockChain& blockChain, const int threads)
+{
+    //Below this many Blocks per thread, starting the threads costs more than it saves
+    static const int MIN_SEGMENT_SIZE = 1 << 14;
+    if (!BlockChainIsOccupied(blockChain) || !isLedgerHead(blockChain) || threads <= 1 ||
+        LedgerSize(*blockChain.ledger) < 2 * MIN_SEGMENT_SIZE) {
+        BlockChainCompress(blockChain);
         return;
     }
-    for (BlockChain* current = &blockChain;
-        current != nullptr && !current->timestamp.empty();
-        current = current->next) {
-        current->transaction.value = function(current->transaction.value);
+    Ledger& ledger = *blockChain.ledger;
+    const int segmentCount = std::min(threads, LedgerSize(ledger) / MIN_SEGMENT_SIZE);
+    const int segmentSize = LedgerSize(ledger) / segmentCount;
+    std::vector<CompressSegment> segments(segmentCount);
+    BlockChain* current = &blockChain;
+    for (int i = 0; i < segmentCount; i++) {
+        segments[i].first = current;
+        if (i > 0) {
+            segments[i - 1].end = current;
+        }
+        for (int step = 0; step < segmentSize && i + 1 < segmentCount; step++) {
+            current = current->next;
+        }
+    }
+    segments.back().end = nullptr;
+
+    std::vector<std::thread> workers;
+    for (CompressSegment& segment : segments) {
+        workers.emplace_back(compressSegment, std::ref(segment));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    //A run may cross segment boundaries, so the first Block of a segment may
+    //still have to merge into the last kept Block before it
+    BlockChain* runEnd = segments[0].last;
+    int removed = segments[0].removed;
+    for (int i = 1; i < segmentCount; i++) {
+        BlockChain* first = segments[i].first;
+        removed += segments[i].removed;
+        if (runEnd->transaction.sender == first->transaction.sender &&
+            runEnd->transaction.receiver == first->transaction.receiver) {
+            runEnd->transaction.value += first->transaction.value;
+            runEnd->next = first->next;
+            removed++;
+            if (segments[i].last != first) {
+                runEnd = segments[i].last;
+            }
+        }
+        else {
+            runEnd = segments[i].last;
+        }
+    }
+    //The removed Blocks stay in the Ledger's chunks and are released in bulk with it
+    ledger.count -= removed;
+    ledger.tail = runEnd;
+    rebuildAttached(blockChain);
+}
+
+//****************************************************************************//
+
+//Writes one merged Block the way BlockChainDump does
+void dumpRun(OutputBuffer& buffer, const int rank, const string& sender,
+    const string& receiver, const unsigned int value, const string& timestamp)
+{
+    OutputBufferWriteNumber(buffer, rank);
+    OutputBufferWrite(buffer, ".\nSender Name: ");
+    OutputBufferWrite(buffer, sender);
+    OutputBufferWrite(buffer, "\nReceiver Name: ");
+    OutputBufferWrite(buffer, receiver);
+    OutputBufferWrite(buffer, "\nTransaction Value: ");
+    OutputBufferWriteNumber(buffer, value);
+    OutputBufferWrite(buffer, "\nTransaction timestamp: ");
+    OutputBufferWrite(buffer, timestamp);
+    OutputBufferWrite(buffer, "\n");
+}
+
+//****************************************************************************//
+
+void BlockChainCompressStream(ifstream& source, ofstream& target)
+{
+    static const size_t CHUNK_SIZE = 1 << 20;
+    OutputBuffer buffer(target);
+    OutputBufferWrite(buffer, "BlockChain Info:\n");
+    //The run being merged, names are kept as text so nothing grows with the accounts
+    string sender;
+    string receiver;
+    string timestamp;
+    unsigned int value = 0;
+    int rank = 0;
+    long long records = 0;
+    std::vector<char> input(CHUNK_SIZE);
+    size_t carried = 0;
+    bool isSourceDone = false;
+    bool isStopped = false;
+    while (!isSourceDone && !isStopped) {
+        //A single record larger than the buffer is the only thing that grows it
+        if (carried == input.size()) {
+            input.resize(input.size() * 2);
+        }
+        {
+            StatsIoScope io;
+            source.read(input.data() + carried, input.size() - carried);
+        }
+        StatsAddBytesRead(source.gcount());
+        isSourceDone = !source;
+        const char* const filled = input.data() + carried + source.gcount();
+        const char* const end = isSourceDone ? filled :
+            LedgerScannerSafeEnd(input.data(), filled);
+        LedgerScanner scanner = {input.data(), end};
+        LedgerRecord record;
+        const char* first = end;
+        while (!LedgerScannerAtEnd(scanner)) {
+            first = scanner.position;
+            if (!LedgerScannerNext(scanner, record)) {
+                //A record cut by the end of the buffer is read again once the rest is in
+                isStopped = isSourceDone || scanner.position != end;
+                break;
+            }
+            first = end;
+            records++;
+            if (rank > 0 && record.sender == sender && record.receiver == receiver) {
+                value += record.value;
+                continue;
+            }
+            if (rank > 0) {
+                dumpRun(buffer, rank, sender, receiver, value, timestamp);
+            }
+            rank++;
+            sender.assign(record.sender.data(), record.sender.size());
+            receiver.assign(record.receiver.data(), record.receiver.size());
+            timestamp.assign(record.timestamp.data(), record.timestamp.size());
+            value = record.value;
+        }
+        carried = filled - first;
+        std::memmove(input.data(), first, carried);
     }
+    StatsAddBlocks(records);
+    if (rank == 0) {
+        std::cerr << "BlockChain is EMPTY! /Compress" << std::endl;
+        return;
+    }
+    dumpRun(buffer, rank, sender, receiver, value, timestamp);
+}
+
+//****************************************************************************//
+
+//TO CHECK: We can assume that the input is correct 
+void BlockChainTransform(BlockChain& blockChain, updateFunction function)
+{
+    BlockChainTransform<updateFunction>(blockChain, function);
+}
+
+//****************************************************************************//
+
+void BlockChainValuesChanged(BlockChain& blockChain)
+{
+    rebuildAttached(blockChain);
 }
 
 //****************************************************************************//
@@ -2,10 +2,15 @@
 #pragma once
 
 #include <iostream>
+#include <limits>
 #include <string>
 #include <fstream>
+#include <vector>
 
 #include "Transaction.h"
+#include "AccountIndex.h"
+#include "Ledger.h"
+#include "TimeIndex.h"
 
 using std::string;
 using std::ifstream;
@@ -23,16 +28,34 @@ typedef unsigned int (*updateFunction)(unsigned int);
 struct BlockChain {
 
       Transaction transaction;
-      string timestamp;
+      Timestamp timestamp;
       BlockChain* next;
+      Ledger* ledger = nullptr;
 
       static void deleteBlockChain(const BlockChain* head);
 };
 
 
+/**
+ * BlockChainIsOccupied - tells whether a Block holds a transaction
+ *
+ * Every transaction has a timestamp, so a Block is occupied exactly when its
+ * timestamp id is not the empty one. Only the head of an empty chain is not.
+ *
+ * @param block Block to check
+*/
+inline bool BlockChainIsOccupied(const BlockChain& block)
+{
+    return block.timestamp.id != 0;
+}
+
+
 /**
  * BlockChainGetSize - returns the number of Blocks in the BlockChain
  *
+ * The size of a chain headed by a Ledger's head is read from the Ledger,
+ * any other chain is walked.
+ *
  * @param blockChain - BlockChain to measure
  *
  * @return Number of Blocks in the BlockChain
@@ -43,6 +66,9 @@ int BlockChainGetSize(const BlockChain& blockChain);
 /**
  * BlockChainPersonalBalance - returns the balance of a given person, relative to a given BlockChain
  *
+ * When called on the head of a Ledger that carries an AccountIndex, the
+ * balance is read from the index instead of scanning the chain.
+ *
  * @param blockChain - BlockChain to calculate the balance from
  * @param name - Name of the person to calculate the balance for
  *
@@ -51,6 +77,19 @@ int BlockChainGetSize(const BlockChain& blockChain);
 int BlockChainPersonalBalance(const BlockChain& blockChain, const string& name);
 
 
+/**
+ * BlockChainAllBalances - returns the balance of every person in the BlockChain
+ *
+ * Answered from the AccountIndex of the owning Ledger when there is one,
+ * otherwise computed in a single pass over the chain.
+ *
+ * @param blockChain BlockChain to calculate the balances from
+ *
+ * @return Balance of every person that sent or received a transaction
+*/
+std::vector<AccountBalance> BlockChainAllBalances(const BlockChain& blockChain);
+
+
 /**
  * BlockChainAppendTransaction - creates and appends a new transaction to the BlockChain
  *
@@ -74,12 +113,12 @@ void BlockChainAppendTransaction(
  *
  * @param blockChain BlockChain to append the transaction to
  * @param transaction Transaction we want to append
- * @param timestamp String that holds the time the transaction was made
+ * @param timestamp Time the transaction was made, a string converts to it
 */
 void BlockChainAppendTransaction(
         BlockChain& blockChain,
         const Transaction& transaction,
-        const string& timestamp
+        Timestamp timestamp
 );
 
 
@@ -94,6 +133,108 @@ void BlockChainAppendTransaction(
 BlockChain BlockChainLoad(ifstream& file);
 
 
+/**
+ * BlockChainLoad - Reads data from a file into the chain owned by a given Ledger
+ *
+ * The Blocks are laid out contiguously in the Ledger in file order, and are
+ * released together with it (BlockChain::deleteBlockChain leaves them alone)
+ *
+ * @param file Data file to read from
+ * @param ledger Ledger that will own the Blocks, its previous chain is cleared
+ *
+ * @return The head of the BlockChain created from the file
+ *
+*/
+BlockChain& BlockChainLoad(ifstream& file, Ledger& ledger);
+
+
+/**
+ * BlockChainLoadMapped - Maps a file into memory and reads it into the chain owned by a given Ledger
+ *
+ * Records are tokenized in place, so no field is copied into a temporary
+ * string on the way. The result is identical to BlockChainLoad.
+ *
+ * @param path Path of the data file to read from
+ * @param ledger Ledger that will own the Blocks, its previous chain is cleared
+ *
+ * @return The head of the BlockChain created from the file, nullptr if the file could not be opened
+ *
+*/
+BlockChain* BlockChainLoadMapped(const string& path, Ledger& ledger);
+
+
+/**
+ * BlockChainLoadParallel - Like BlockChainLoadMapped, but parses the file on several threads
+ *
+ * The file is split on newline boundaries into one part per thread, each
+ * part is parsed into its own sub-chain, and the sub-chains are linked in
+ * file order. If a record turns out to cross a split point the file is
+ * parsed again serially, so the result is always identical to BlockChainLoad.
+ *
+ * @param path Path of the data file to read from
+ * @param ledger Ledger that will own the Blocks, its previous chain is cleared
+ * @param threads Number of threads to parse with
+ *
+ * @return The head of the BlockChain created from the file, nullptr if the file could not be opened
+ *
+*/
+BlockChain* BlockChainLoadParallel(const string& path, Ledger& ledger, int threads);
+
+
+/**
+ * BlockChainSaveBinary - Writes the BlockChain to a file in the binary ledger format
+ *
+ * The format (see LedgerBinary.h) stores every name once in a dictionary
+ * and every Block as a fixed-width record, so BlockChainLoadBinary reads it
+ * back without parsing any text.
+ *
+ * @param blockChain BlockChain to save
+ * @param file File to write to, opened in binary mode
+ *
+ * @return true if everything was written, false otherwise
+ *
+*/
+bool BlockChainSaveBinary(const BlockChain& blockChain, ofstream& file);
+
+
+/**
+ * BlockChainIsBinary - Tells whether a file holds a binary ledger
+ *
+ * @param path Path of the file to check
+ *
+ * @return true if the file starts with a binary header that matches its size, false otherwise
+ *
+*/
+bool BlockChainIsBinary(const string& path);
+
+
+/**
+ * BlockChainLoadBinary - Reads a binary ledger into the chain owned by a given Ledger
+ *
+ * @param path Path of the file written by BlockChainSaveBinary
+ * @param ledger Ledger that will own the Blocks, its previous chain is cleared
+ *
+ * @return The head of the BlockChain read from the file, nullptr if the file
+ * could not be opened or is not a whole binary ledger of a known version
+ *
+*/
+BlockChain* BlockChainLoadBinary(const string& path, Ledger& ledger);
+
+
+/**
+ * BlockChainLoadBinary - Reads a binary ledger held in memory into the chain owned by a given Ledger
+ *
+ * @param data Start of the binary ledger
+ * @param size Size of the binary ledger
+ * @param ledger Ledger that will own the Blocks, its previous chain is cleared
+ *
+ * @return The head of the BlockChain read from the buffer, nullptr if it is
+ * not a whole binary ledger of a known version
+ *
+*/
+BlockChain* BlockChainLoadBinary(const char* data, size_t size, Ledger& ledger);
+
+
 /**
  * BlockChainDump - Prints the data of all transactions in the BlockChain to a given file
  *
@@ -106,6 +247,9 @@ BlockChain BlockChainLoad(ifstream& file);
  * Transaction Value: <value>
  * Transaction Timestamp: <time>
  *
+ * The text is formatted into an OutputBuffer and written out in large
+ * chunks rather than flushed line by line.
+ *
  * @param blockChain BlockChain to print
  * @param file File to print to
  *
@@ -130,6 +274,51 @@ void BlockChainDump(const BlockChain& blockChain, ofstream& file);
 void BlockChainDumpHashed(const BlockChain& blockChain, ofstream& file);
 
 
+/**
+ * BlockChainPersonalBalanceWindow - returns the balance of a given person over a window of time
+ *
+ * Timestamps are read as "HH:MM" or "HH:MM:SS". With a TimeIndex attached
+ * to the chain's Ledger the balance takes time logarithmic in the chain's
+ * length, otherwise the chain is scanned.
+ *
+ * @param blockChain BlockChain to sum over
+ * @param name Name of the person
+ * @param from Start of the window, included
+ * @param to End of the window, excluded
+ *
+ * @return Balance of the person over the Blocks in the window, 0 for a malformed window
+*/
+int BlockChainPersonalBalanceWindow(const BlockChain& blockChain, const string& name,
+    const string& from, const string& to);
+
+
+/**
+ * BlockChainDumpWindow - Like BlockChainDump, but prints only the Blocks in a window of time
+ *
+ * Blocks keep the ranks they have in the whole chain. With a TimeIndex the
+ * Blocks are found in time logarithmic in the chain's length plus their number.
+ *
+ * @param blockChain BlockChain to print
+ * @param from Start of the window, included
+ * @param to End of the window, excluded
+ * @param file File to print to
+*/
+void BlockChainDumpWindow(const BlockChain& blockChain, const string& from,
+    const string& to, ofstream& file);
+
+
+/**
+ * BlockChainDumpHashedWindow - Like BlockChainDumpHashed, but prints only the Blocks in a window of time
+ *
+ * @param blockChain BlockChain to print
+ * @param from Start of the window, included
+ * @param to End of the window, excluded
+ * @param file File to print to
+*/
+void BlockChainDumpHashedWindow(const BlockChain& blockChain, const string& from,
+    const string& to, ofstream& file);
+
+
 /**
  * BlockChainVerifyFile - verifies that the file contains correct hashed messages of the given BlockChain
  *
@@ -147,26 +336,225 @@ void BlockChainDumpHashed(const BlockChain& blockChain, ofstream& file);
 bool BlockChainVerifyFile(const BlockChain& blockChain, std::ifstream& file);
 
 
+/**
+ * BlockChainVerifyFile - verifies the file like above, and tells where it first differs
+ *
+ * The file is read once, comparing every line as it arrives. A missing or
+ * an extra line counts as a mismatch at the position where it occurs.
+ *
+ * @param blockChain BlockChain to verify
+ * @param file File to read from
+ * @param mismatch Set to the rank (from 1, as in BlockChainDump) of the first
+ *      Block whose line differs, or to 0 if the file is valid or the chain empty
+ *
+ * @return true if the file is valid, false otherwise
+*/
+bool BlockChainVerifyFile(const BlockChain& blockChain, std::ifstream& file,
+        int& mismatch);
+
+
+/**
+ * BlockChainDumpHashedParallel - Like BlockChainDumpHashed, but hashes the Blocks on several threads
+ *
+ * Blocks are hashed in batches on a thread pool, and the batches are
+ * written to the file in chain order, so the output is identical.
+ *
+ * @param blockChain BlockChain to print
+ * @param file File to print to
+ * @param threads Number of threads to hash with
+ *
+*/
+void BlockChainDumpHashedParallel(const BlockChain& blockChain, ofstream& file,
+        int threads);
+
+
+/**
+ * BlockChainVerifyFileParallel - Like BlockChainVerifyFile, but hashes the Blocks on several threads
+ *
+ * Batches of Blocks and the matching lines of the file are compared on a
+ * thread pool, in a single pass over the file. Once a mismatch is found no
+ * more lines are read.
+ *
+ * @param blockChain BlockChain to verify
+ * @param file File to read from
+ * @param threads Number of threads to hash with
+ *
+ * @return true if the file is valid, false otherwise
+*/
+bool BlockChainVerifyFileParallel(const BlockChain& blockChain, std::ifstream& file,
+        int threads);
+
+
+/**
+ * BlockChainVerifyFileParallel - Like above, and tells where the file first differs
+ *
+ * Workers past an already known mismatch stop, the ones before it keep
+ * going, so the reported rank is always the first one.
+ *
+ * @param blockChain BlockChain to verify
+ * @param file File to read from
+ * @param threads Number of threads to hash with
+ * @param mismatch Set as in BlockChainVerifyFile
+ *
+ * @return true if the file is valid, false otherwise
+*/
+bool BlockChainVerifyFileParallel(const BlockChain& blockChain, std::ifstream& file,
+        int threads, int& mismatch);
+
+
 /**
  * BlockChainCompress - Compresses the given block chain based on the transaction's data.
  * All consecutive blocks with the same sender and receiver will be compressed to one Block.
+ * Merging never changes a balance, so an attached AccountIndex stays valid as is.
  *
  * @param blockChain BlockChain to compress
 */
 void BlockChainCompress(BlockChain& blockChain);
 
 
+/**
+ * BlockChainCompressParallel - Like BlockChainCompress, but compresses on several threads
+ *
+ * The chain of a Ledger is split into one segment per thread, each segment
+ * is compressed on its own, and the runs that cross segment boundaries are
+ * merged afterwards, so the result is identical to BlockChainCompress.
+ * The removed Blocks are left to the Ledger, which frees them in bulk.
+ * Small chains and chains not headed by a Ledger are compressed serially.
+ *
+ * @param blockChain BlockChain to compress
+ * @param threads Number of threads to compress with
+*/
+void BlockChainCompressParallel(BlockChain& blockChain, int threads);
+
+
+/**
+ * BlockChainCompressStream - Compresses a data file and writes it as BlockChainDump would
+ *
+ * Reads the file in fixed-size chunks, merges each run of Blocks as soon as
+ * it ends and writes it out at once, so the output is the same as loading
+ * the file, compressing it and dumping it, while memory stays bounded by
+ * the chunk size and the longest record whatever the size of the file.
+ *
+ * @param source Data file to read from
+ * @param target File to write to
+*/
+void BlockChainCompressStream(ifstream& source, ofstream& target);
+
+
 /**
  * BlockChainTransform - Update the values of each transaction in the BlockChain
  *
+ * Calls through the pointer for every Block. The templated overload below
+ * takes any callable instead, which the compiler can inline into the loop.
+ *
  * @param blockChain BlockChain to update
  * @param function a pointer to a transform function
 */
 void BlockChainTransform(BlockChain& blockChain, updateFunction function);
 
+
+/**
+ * BlockChainValuesChanged - Brings the structures attached to the chain's Ledger
+ * up to date after values were changed in place
+ *
+ * The templated transforms call it once they are done; an attached
+ * AccountIndex is adjusted Block by Block as values change instead.
+ *
+ * @param blockChain BlockChain whose values changed
+*/
+void BlockChainValuesChanged(BlockChain& blockChain);
+
 /**
  * TimesTwo - Returns a recived integer value multiplied by two
  *
  * @param value An integer value to be multiplied
 */
 unsigned int TimesTwo(unsigned int value);
+
+
+//****************************************************************************//
+
+//Applies function to the value of every Block up to rank last chosen by selected(rank, block)
+template <typename Function, typename Selector>
+void BlockChainTransformSelected(BlockChain& blockChain, Function& function,
+    const int last, Selector selected)
+{
+    if(!BlockChainIsOccupied(blockChain)){
+        std::cerr << "BlockChain is EMPTY! /Transform" << std::endl;
+        return;
+    }
+    AccountIndex* index = blockChain.ledger != nullptr ? blockChain.ledger->index : nullptr;
+    int rank = 1;
+    for (BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current) && rank <= last;
+        current = current->next, rank++) {
+        if (!selected(rank, *current)) {
+            continue;
+        }
+        const unsigned int oldValue = current->transaction.value;
+        current->transaction.value = function(oldValue);
+        if (index != nullptr) {
+            AccountIndexAdjust(*index, current->transaction, oldValue);
+        }
+    }
+    BlockChainValuesChanged(blockChain);
+}
+
+
+/**
+ * BlockChainTransform - Update the values of each transaction in the BlockChain
+ *
+ * @param blockChain BlockChain to update
+ * @param function Any callable taking and returning an unsigned int,
+ * such as a lambda or a functor, called directly so it can be inlined
+*/
+template <typename Function>
+void BlockChainTransform(BlockChain& blockChain, Function function)
+{
+    BlockChainTransformSelected(blockChain, function, std::numeric_limits<int>::max(),
+        [](int, const BlockChain&) { return true; });
+}
+
+
+/**
+ * BlockChainTransformRange - Update the values of the Blocks in a window of ranks
+ *
+ * @param blockChain BlockChain to update
+ * @param first Rank of the first Block to update, from 1 at the head as in BlockChainDump
+ * @param last Rank of the last Block to update
+ * @param function Any callable taking and returning an unsigned int
+*/
+template <typename Function>
+void BlockChainTransformRange(BlockChain& blockChain, const int first, const int last,
+    Function function)
+{
+    BlockChainTransformSelected(blockChain, function, last,
+        [first](const int rank, const BlockChain&) { return first <= rank; });
+}
+
+
+/**
+ * BlockChainTransformWindow - Update the values of the Blocks in a window of time
+ *
+ * Selects the same Blocks as BlockChainDumpWindow, nothing for a malformed window.
+ *
+ * @param blockChain BlockChain to update
+ * @param from Start of the window, included
+ * @param to End of the window, excluded
+ * @param function Any callable taking and returning an unsigned int
+*/
+template <typename Function>
+void BlockChainTransformWindow(BlockChain& blockChain, const string& from,
+    const string& to, Function function)
+{
+    const int fromTime = TimeIndexParse(from);
+    const int toTime = TimeIndexParse(to);
+    if (fromTime == TimeIndex::INVALID_TIME || toTime == TimeIndex::INVALID_TIME) {
+        return;
+    }
+    BlockChainTransformSelected(blockChain, function, std::numeric_limits<int>::max(),
+        [fromTime, toTime](int, const BlockChain& block) {
+            const int time = TimeIndexParse(block.timestamp.text());
+            return time != TimeIndex::INVALID_TIME && fromTime <= time && time < toTime;
+        });
+}
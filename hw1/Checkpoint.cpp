@@ -0,0 +1,252 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "Checkpoint.h"
+#include "BlockChain.h"
+#include "ConcurrentChain.h"
+#include "LedgerBinary.h"
+#include "MappedFile.h"
+#include "TransactionLog.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define CHECKPOINT_FSYNC
+#endif
+
+//****************************************************************************//
+
+//Syncs a file or a directory that is already written, elsewhere there is nothing to do
+bool syncPath(const string& path)
+{
+#ifdef CHECKPOINT_FSYNC
+    const int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    const bool isSynced = fsync(descriptor) == 0;
+    close(descriptor);
+    return isSynced;
+#else
+    return true;
+#endif
+}
+
+//****************************************************************************//
+
+bool CheckpointWrite(const BlockChain& blockChain, const long long position,
+    const string& path)
+{
+    const string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        CheckpointHeader header = {};
+        std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+        header.version = CHECKPOINT_VERSION;
+        header.position = position;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!BlockChainSaveBinary(blockChain, file) || !file.flush()) {
+            return false;
+        }
+    }
+    if (!syncPath(temporary) || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        return false;
+    }
+    //The rename itself only lasts once the directory is synced
+    const size_t slash = path.find_last_of('/');
+    syncPath(slash == string::npos ? "." : path.substr(0, slash + 1));
+    return true;
+}
+
+//****************************************************************************//
+
+bool CheckpointIsCheckpoint(const string& path)
+{
+    //The image after the header is checked like BlockChainIsBinary checks a whole file
+    CheckpointHeader header;
+    LedgerBinaryHeader image;
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    const std::streamoff size = file.tellg();
+    return file && file.seekg(0).read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+        std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == CHECKPOINT_VERSION &&
+        file.read(reinterpret_cast<char*>(&image), sizeof(image)) &&
+        LedgerBinaryCheckHeader(image, uint64_t(size) - sizeof(header));
+}
+
+//****************************************************************************//
+
+BlockChain* CheckpointLoad(const string& path, Ledger& ledger, long long& position)
+{
+    MappedFile file;
+    if (!CheckpointIsCheckpoint(path) || !MappedFileOpen(file, path) ||
+        file.size < sizeof(CheckpointHeader)) {
+        return nullptr;
+    }
+    CheckpointHeader header;
+    std::memcpy(&header, file.data, sizeof(header));
+    BlockChain* blockChain = BlockChainLoadBinary(file.data + sizeof(header),
+        file.size - sizeof(header), ledger);
+    if (blockChain != nullptr) {
+        position = header.position;
+    }
+    return blockChain;
+}
+
+//****************************************************************************//
+
+//Tells whether anything can be opened at the given path
+bool fileExists(const string& path)
+{
+    return std::ifstream(path).is_open();
+}
+
+//****************************************************************************//
+
+long long CheckpointRestore(ConcurrentChain& chain, const string& checkpointPath,
+    const string& logPath)
+{
+    long long position = 0;
+    if (fileExists(checkpointPath)) {
+        if (CheckpointLoad(checkpointPath, chain.ledger, position) == nullptr) {
+            return -1;
+        }
+        //Published as a chain of its own, as ConcurrentChainAppend leaves its Blocks
+        for (BlockChain* current = &LedgerHead(chain.ledger); current != nullptr;
+            current = current->next) {
+            current->ledger = &chain.owner;
+        }
+        if (LedgerSize(chain.ledger) > 0) {
+            chain.head.store(&LedgerHead(chain.ledger));
+            chain.size.store(LedgerSize(chain.ledger));
+        }
+    }
+    if (fileExists(logPath)) {
+        //The tail is replayed apart, then appended again oldest first
+        Ledger tail;
+        if (TransactionLogReplayFrom(logPath, position, LedgerHead(tail)) < 0) {
+            return -1;
+        }
+        std::vector<const BlockChain*> blocks;
+        for (const BlockChain* current = &LedgerHead(tail);
+            current != nullptr && BlockChainIsOccupied(*current);
+            current = current->next) {
+            blocks.push_back(current);
+        }
+        for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
+            ConcurrentChainAppend(chain, (*it)->transaction, (*it)->timestamp.text());
+        }
+    }
+    return ConcurrentChainRead(chain).size;
+}
+
+//****************************************************************************//
+
+Checkpointer::Checkpointer() : chain(nullptr), period(0), isRequested(false),
+    stopping(false), written(-1)
+{
+}
+
+//****************************************************************************//
+
+Checkpointer::~Checkpointer()
+{
+    CheckpointerStop(*this);
+}
+
+//****************************************************************************//
+
+//Saves the latest committed snapshot unless the previous checkpoint already holds it
+void writeCheckpoint(Checkpointer& checkpointer)
+{
+    bool isCommitted;
+    const ConcurrentChainSnapshot snapshot =
+        ConcurrentChainReadCommitted(*checkpointer.chain, isCommitted);
+    if (!isCommitted) {
+        std::cerr << "Transaction log commit FAILED! /Checkpoint" << std::endl;
+        return;
+    }
+    if (snapshot.size == CheckpointerWritten(checkpointer)) {
+        return;
+    }
+    if (!CheckpointWrite(*snapshot.head, snapshot.size, checkpointer.path)) {
+        std::cerr << "Checkpoint write FAILED! /Checkpoint" << std::endl;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(checkpointer.mutex);
+    checkpointer.written = snapshot.size;
+}
+
+//****************************************************************************//
+
+//Body of the checkpointer's thread, the last checkpoint is written once it is stopped
+void runCheckpointer(Checkpointer& checkpointer)
+{
+    std::unique_lock<std::mutex> lock(checkpointer.mutex);
+    while (true) {
+        checkpointer.wakeUp.wait_for(lock, checkpointer.period, [&checkpointer]() {
+            return checkpointer.isRequested || checkpointer.stopping;
+        });
+        const bool isLast = checkpointer.stopping;
+        checkpointer.isRequested = false;
+        lock.unlock();
+        writeCheckpoint(checkpointer);
+        if (isLast) {
+            return;
+        }
+        lock.lock();
+    }
+}
+
+//****************************************************************************//
+
+void CheckpointerStart(Checkpointer& checkpointer, ConcurrentChain& chain,
+    const string& path, const std::chrono::milliseconds period)
+{
+    checkpointer.chain = &chain;
+    checkpointer.path = path;
+    checkpointer.period = period;
+    checkpointer.isRequested = false;
+    checkpointer.stopping = false;
+    checkpointer.worker = std::thread(runCheckpointer, std::ref(checkpointer));
+}
+
+//****************************************************************************//
+
+void CheckpointerRequest(Checkpointer& checkpointer)
+{
+    {
+        std::lock_guard<std::mutex> lock(checkpointer.mutex);
+        checkpointer.isRequested = true;
+    }
+    checkpointer.wakeUp.notify_one();
+}
+
+//****************************************************************************//
+
+long long CheckpointerWritten(Checkpointer& checkpointer)
+{
+    std::lock_guard<std::mutex> lock(checkpointer.mutex);
+    return checkpointer.written;
+}
+
+//****************************************************************************//
+
+void CheckpointerStop(Checkpointer& checkpointer)
+{
+    if (!checkpointer.worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(checkpointer.mutex);
+        checkpointer.stopping = true;
+    }
+    checkpointer.wakeUp.notify_one();
+    checkpointer.worker.join();
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using std::string;
+
+struct BlockChain;
+struct Ledger;
+struct ConcurrentChain;
+
+
+//  Layout of a checkpoint file, all integers in the byte order of the writer:
+//
+//    header    magic "HW1C", version, number of log records the image covers
+//    image     the chain in the binary ledger format (see LedgerBinary.h)
+
+static const char CHECKPOINT_MAGIC[4] = {'H', 'W', '1', 'C'};
+static const uint32_t CHECKPOINT_VERSION = 1;
+
+struct CheckpointHeader {
+
+      char magic[4];
+      uint32_t version;
+      uint64_t position;
+};
+
+
+/**
+ * CheckpointWrite - writes a chain and the log position it covers to a checkpoint file
+ *
+ * The checkpoint is written to a temporary file, synced and renamed over
+ * the given path, so a crash leaves either the previous checkpoint or the
+ * new one, never a torn file.
+ *
+ * @param blockChain Head of the chain to save
+ * @param position Number of log records the chain holds
+ * @param path Path of the checkpoint file
+ *
+ * @return true if the checkpoint reached the disk, false otherwise
+*/
+bool CheckpointWrite(const BlockChain& blockChain, long long position, const string& path);
+
+
+/**
+ * CheckpointIsCheckpoint - tells whether a file holds a checkpoint
+ *
+ * @param path Path of the file to check
+*/
+bool CheckpointIsCheckpoint(const string& path);
+
+
+/**
+ * CheckpointLoad - reads a checkpoint into the chain owned by a given Ledger
+ *
+ * Whatever is attached to the Ledger is rebuilt, as BlockChainLoadBinary does.
+ *
+ * @param path Path of the checkpoint file
+ * @param ledger Ledger that will own the Blocks, its previous chain is cleared
+ * @param position Set to the number of log records the chain holds
+ *
+ * @return The head of the chain, nullptr if the file is not a whole checkpoint
+*/
+BlockChain* CheckpointLoad(const string& path, Ledger& ledger, long long& position);
+
+
+/**
+ * CheckpointRestore - rebuilds a ConcurrentChain from its latest checkpoint and its log
+ *
+ * The checkpoint is loaded when there is one, then only the log records it
+ * does not hold are replayed. Must run before any other thread uses the
+ * chain, and before the log is attached to it again.
+ *
+ * @param chain Empty chain to restore into
+ * @param checkpointPath Path of the checkpoint file, which may be missing
+ * @param logPath Path of the log file, which may be missing
+ *
+ * @return The number of Blocks restored, -1 if either file exists but is not
+ * what it should be
+*/
+long long CheckpointRestore(ConcurrentChain& chain, const string& checkpointPath,
+    const string& logPath);
+
+
+/**
+*
+ * Checkpointer - Writes checkpoints of a ConcurrentChain on a thread of its own
+ *
+ * Every period, or as soon as one is requested, the checkpointer commits
+ * the log of the chain, takes the latest snapshot and writes it out. Appends
+ * only wait for the commit: the snapshot is written while they go on.
+ *
+*/
+struct Checkpointer {
+
+      ConcurrentChain* chain;
+      string path;
+      std::chrono::milliseconds period;
+      std::thread worker;
+      std::mutex mutex;
+      std::condition_variable wakeUp;
+      bool isRequested;
+      bool stopping;
+      //Size of the chain in the latest checkpoint, -1 before the first one
+      long long written;
+
+      Checkpointer();
+      Checkpointer(const Checkpointer&) = delete;
+      Checkpointer& operator=(const Checkpointer&) = delete;
+      ~Checkpointer();
+};
+
+
+/**
+ * CheckpointerStart - starts writing checkpoints of a chain
+ *
+ * @param checkpointer Checkpointer to start, it must not be running
+ * @param chain Chain to save
+ * @param path Path of the checkpoint file
+ * @param period Time between two checkpoints
+*/
+void CheckpointerStart(Checkpointer& checkpointer, ConcurrentChain& chain,
+    const string& path, std::chrono::milliseconds period);
+
+
+/**
+ * CheckpointerRequest - asks for a checkpoint without waiting for the period to end
+ *
+ * @param checkpointer Running checkpointer
+*/
+void CheckpointerRequest(Checkpointer& checkpointer);
+
+
+/**
+ * CheckpointerWritten - returns the size of the chain in the latest checkpoint written
+ *
+ * @param checkpointer Checkpointer to ask
+ *
+ * @return Number of Blocks, -1 if no checkpoint was written yet
+*/
+long long CheckpointerWritten(Checkpointer& checkpointer);
+
+
+/**
+ * CheckpointerStop - writes a last checkpoint and stops the thread
+ *
+ * @param checkpointer Checkpointer to stop, nothing happens if it is not running
+*/
+void CheckpointerStop(Checkpointer& checkpointer);
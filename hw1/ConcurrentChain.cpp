@@ -0,0 +1,84 @@
+#include <iostream>
+
+#include "ConcurrentChain.h"
+
+//****************************************************************************//
+
+ConcurrentChain::ConcurrentChain() : sequence(0), head(&empty), size(0), log(nullptr)
+{
+    empty.next = nullptr;
+    empty.ledger = &owner;
+}
+
+//****************************************************************************//
+
+//Replaces the latest snapshot, readers retry if they read while the count is odd or moves
+void publish(ConcurrentChain& chain, const BlockChain* head, const int size)
+{
+    const unsigned int sequence = chain.sequence.load(std::memory_order_relaxed);
+    chain.sequence.store(sequence + 1, std::memory_order_relaxed);
+    //A reader that sees either new value also sees the odd count
+    chain.head.store(head, std::memory_order_release);
+    chain.size.store(size, std::memory_order_release);
+    chain.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+//****************************************************************************//
+
+void ConcurrentChainAppend(ConcurrentChain& chain, const Transaction& transaction,
+    const string& timestamp)
+{
+    std::lock_guard<std::mutex> lock(chain.writer);
+    const int size = chain.size.load(std::memory_order_relaxed);
+    BlockChain* block = LedgerNewBlock(chain.ledger);
+    block->transaction = transaction;
+    block->timestamp = Timestamp(timestamp);
+    block->next = size == 0 ? nullptr :
+        const_cast<BlockChain*>(chain.head.load(std::memory_order_relaxed));
+    //Read as a chain of its own, not as the chain of the Ledger that keeps growing
+    block->ledger = &chain.owner;
+    publish(chain, block, size + 1);
+    if (chain.log != nullptr && !TransactionLogAppend(*chain.log, transaction, timestamp)) {
+        std::cerr << "Transaction log commit FAILED! /ConcurrentAppend" << std::endl;
+    }
+}
+
+//****************************************************************************//
+
+void ConcurrentChainAppend(ConcurrentChain& chain, const unsigned int value,
+    const string& sender, const string& receiver, const string& timestamp)
+{
+    const Transaction transaction = {value, sender, receiver};
+    ConcurrentChainAppend(chain, transaction, timestamp);
+}
+
+//****************************************************************************//
+
+ConcurrentChainSnapshot ConcurrentChainRead(const ConcurrentChain& chain)
+{
+    while (true) {
+        const unsigned int sequence = chain.sequence.load(std::memory_order_acquire);
+        const ConcurrentChainSnapshot snapshot = {chain.head.load(std::memory_order_acquire),
+            chain.size.load(std::memory_order_acquire)};
+        if (sequence % 2 == 0 && chain.sequence.load(std::memory_order_relaxed) == sequence) {
+            return snapshot;
+        }
+    }
+}
+
+//****************************************************************************//
+
+void ConcurrentChainAttachLog(ConcurrentChain& chain, TransactionLog* log)
+{
+    std::lock_guard<std::mutex> lock(chain.writer);
+    chain.log = log;
+}
+
+//****************************************************************************//
+
+ConcurrentChainSnapshot ConcurrentChainReadCommitted(ConcurrentChain& chain, bool& isCommitted)
+{
+    std::lock_guard<std::mutex> lock(chain.writer);
+    isCommitted = chain.log == nullptr || TransactionLogCommit(*chain.log);
+    return {chain.head.load(std::memory_order_relaxed), chain.size.load(std::memory_order_relaxed)};
+}
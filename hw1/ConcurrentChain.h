@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "BlockChain.h"
+#include "Ledger.h"
+#include "TransactionLog.h"
+
+using std::string;
+
+
+/**
+*
+ * ConcurrentChainSnapshot - The chain as it was at one point in time
+ *
+ * The Blocks reachable from head never change once published, so any
+ * function taking a const BlockChain& may read them while appends go on.
+ * They belong to the ConcurrentChain and must not be changed or freed:
+ * they name a Ledger as their owner, so BlockChain::deleteBlockChain leaves
+ * them alone.
+ *
+*/
+struct ConcurrentChainSnapshot {
+
+      const BlockChain* head;
+      int size;
+};
+
+
+/**
+*
+ * ConcurrentChain - A BlockChain that one or more threads append to while
+ * others read it
+ *
+ * BlockChainAppendTransaction rewrites the head Block in place, so a plain
+ * chain cannot be read during an append. Here an append instead fills a
+ * fresh Block that points to the current head, and then publishes the new
+ * head and size under a sequence count, which is odd while they change.
+ * Readers take no lock: they read both and only retry if the count moved
+ * meanwhile. Nothing is kept per snapshot, and the Blocks a snapshot reaches
+ * are never changed or freed while the ConcurrentChain lives. Writers only
+ * wait for each other.
+ *
+ * The ledger only provides the memory of the Blocks: its head stays empty.
+ * The published Blocks name owner instead, a Ledger that never changes, so
+ * reading them races with no append and nothing attached to a Ledger is
+ * maintained. A TransactionLog may be attached to the ConcurrentChain
+ * itself instead, to record every append.
+ *
+*/
+struct ConcurrentChain {
+
+      Ledger ledger;
+      //Named as the owner of every published Block, and left empty
+      Ledger owner;
+      //Head of every snapshot of an empty chain
+      BlockChain empty;
+      std::mutex writer;
+      //The latest snapshot, published under the sequence count
+      std::atomic<unsigned int> sequence;
+      std::atomic<const BlockChain*> head;
+      std::atomic<int> size;
+      TransactionLog* log;
+
+      ConcurrentChain();
+      ConcurrentChain(const ConcurrentChain&) = delete;
+      ConcurrentChain& operator=(const ConcurrentChain&) = delete;
+};
+
+
+/**
+ * ConcurrentChainAppend - appends a copy of a given transaction and publishes it
+ *
+ * @param chain Chain to append to
+ * @param transaction Transaction to append
+ * @param timestamp String that holds the time the transaction was made
+*/
+void ConcurrentChainAppend(ConcurrentChain& chain, const Transaction& transaction,
+    const string& timestamp);
+
+
+/**
+ * ConcurrentChainAppend - creates a new transaction, appends it and publishes it
+ *
+ * @param chain Chain to append to
+ * @param value Value of the transaction
+ * @param sender Name of the sender
+ * @param receiver Name of the receiver
+ * @param timestamp String that holds the time the transaction was made
+*/
+void ConcurrentChainAppend(ConcurrentChain& chain, unsigned int value,
+    const string& sender, const string& receiver, const string& timestamp);
+
+
+/**
+ * ConcurrentChainRead - returns the latest published snapshot without taking a lock
+ *
+ * @param chain Chain to read
+ *
+ * @return Snapshot whose head is an empty Block while nothing was appended
+*/
+ConcurrentChainSnapshot ConcurrentChainRead(const ConcurrentChain& chain);
+
+
+/**
+ * ConcurrentChainAttachLog - attaches a TransactionLog that records the appends from now on
+ *
+ * @param chain Chain to attach to
+ * @param log Open log to append to, or nullptr to detach the current one
+*/
+void ConcurrentChainAttachLog(ConcurrentChain& chain, TransactionLog* log);
+
+
+/**
+ * ConcurrentChainReadCommitted - commits the attached log and returns the latest snapshot
+ *
+ * Appends wait for the commit, which is what every full batch of the log
+ * costs them anyway. Every Block of the snapshot is then in the log, in the
+ * first snapshot.size records.
+ *
+ * @param chain Chain to read
+ * @param isCommitted Set to false if the commit failed
+ *
+ * @return The latest snapshot, as ConcurrentChainRead returns it
+*/
+ConcurrentChainSnapshot ConcurrentChainReadCommitted(ConcurrentChain& chain, bool& isCommitted);
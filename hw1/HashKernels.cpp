@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "HashKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define HASH_KERNELS_X86
+#endif
+
+//****************************************************************************//
+
+//  Only the low four bits of every digest byte survive the final step, so
+//  the kernels below work out those bits only.
+//
+//  Step i of hash() XORs name[i % size] ^ i into a digest byte that repeats
+//  every PERIOD steps: 10 for value1 (byte i % 10) and 20 for value2 (byte
+//  10 + i % 20 / 2). The low bits of i repeat every 16 steps. A vector of W
+//  bytes (W = 16 or 32) thus sees the same PERIOD buckets, and the same low
+//  bits of i, every 5 vectors. The kernels XOR the repeated name into 5
+//  accumulators, add the bits of i once per odd number of groups, and then
+//  fold the accumulated lanes into PERIOD buckets.
+
+static const int OUT_SIZE = 20;
+static const int HALF_SIZE = OUT_SIZE / 2;
+static const int GROUP_VECTORS = 5;
+
+//****************************************************************************//
+
+//Turns the accumulated low bits into the printable digest
+string finishDigest(const int key, const char* firstBuckets,
+    const char* secondBuckets)
+{
+    char bytes[OUT_SIZE + 1] = {0};
+    for (int i = 0; i < HALF_SIZE; i++) {
+        bytes[i] = firstBuckets[i];
+        bytes[HALF_SIZE + i] = secondBuckets[2 * i] ^ secondBuckets[2 * i + 1];
+    }
+    for (int i = 0; i < OUT_SIZE; i++) {
+        bytes[i] = (key ^ (OUT_SIZE - i) ^ bytes[i]) & 0x0f;
+        bytes[i] += (bytes[i] < 10) ? '0' : 'a' - 10;
+    }
+    return string(bytes);
+}
+
+//****************************************************************************//
+
+string hashScalar(int key, const string& value1, const string& value2) {
+    static const int out_size = 20;
+    char bytes[out_size + 1] = {0};
+    for (int i = 0; i < out_size; i++) {
+        bytes[i] = key ^ (out_size - i);
+    }
+    for (size_t i = 0; i < value1.size() * out_size ; i++) {
+        bytes[i % (out_size/2)] ^= value1[i % value1.size()] ^ i;
+    }
+    for (size_t i = 0; i < value2.size() * out_size ; i++) {
+        bytes[(out_size/2) + (i % out_size/2)] ^= value2[i % value2.size()] ^ i;
+    }
+    for (int i = 0; i < out_size; i++) {
+        bytes[i] &= 0x0f;
+        bytes[i] += (bytes[i] < 10) ? '0' : 'a' - 10;
+    }
+    return string(bytes);
+}
+
+//****************************************************************************//
+
+//Runs steps [i, size * OUT_SIZE) one at a time into PERIOD buckets
+template <int PERIOD>
+void foldRemainder(const string& name, size_t i, char* buckets)
+{
+    if (name.empty()) {
+        return;
+    }
+    size_t position = i % name.size();
+    int bucket = i % PERIOD;
+    for (; i < name.size() * OUT_SIZE; i++) {
+        buckets[bucket] ^= name[position] ^ i;
+        if (++position == name.size()) {
+            position = 0;
+        }
+        if (++bucket == PERIOD) {
+            bucket = 0;
+        }
+    }
+}
+
+//****************************************************************************//
+
+//Folds the lanes of one group into PERIOD buckets, lane l belonging to bucket l % PERIOD
+template <int PERIOD>
+void foldLanes(const char* lanes, const int count, char* buckets)
+{
+    for (int block = 0; block < count; block += PERIOD) {
+        for (int bucket = 0; bucket < PERIOD; bucket++) {
+            buckets[bucket] ^= lanes[block + bucket];
+        }
+    }
+}
+
+#ifdef HASH_KERNELS_X86
+
+//****************************************************************************//
+
+//The name repeated often enough that W bytes can be loaded from any position below its size
+struct RepeatedName {
+    char local[256];
+    std::vector<char> heap;
+    const char* data;
+
+    RepeatedName(const string& name, const size_t width) {
+        const size_t size = name.size() + width;
+        char* target = local;
+        if (size > sizeof(local)) {
+            heap.resize(size);
+            target = heap.data();
+        }
+        for (size_t i = 0; i < size; i += name.size()) {
+            std::memcpy(target + i, name.data(), std::min(name.size(), size - i));
+        }
+        data = target;
+    }
+};
+
+//****************************************************************************//
+
+//Folds steps [first, size * OUT_SIZE), first being a multiple of a whole group
+template <int PERIOD>
+void foldNameSse2(const string& name, char* buckets, const size_t first = 0)
+{
+    static const int WIDTH = 16;
+    const size_t groups = (name.size() * OUT_SIZE - first) / (WIDTH * GROUP_VECTORS);
+    if (groups > 0) {
+        const RepeatedName repeated(name, WIDTH);
+        const size_t step = WIDTH % name.size();
+        __m128i sums[GROUP_VECTORS];
+        for (int v = 0; v < GROUP_VECTORS; v++) {
+            sums[v] = _mm_setzero_si128();
+        }
+        size_t position = first % name.size();
+        for (size_t group = 0; group < groups; group++) {
+            for (int v = 0; v < GROUP_VECTORS; v++) {
+                sums[v] = _mm_xor_si128(sums[v], _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(repeated.data + position)));
+                position += step;
+                if (position >= name.size()) {
+                    position -= name.size();
+                }
+            }
+        }
+        const __m128i indexBits = (groups % 2 == 1) ?
+            _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15) :
+            _mm_setzero_si128();
+        alignas(16) char lanes[WIDTH * GROUP_VECTORS];
+        for (int v = 0; v < GROUP_VECTORS; v++) {
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes + v * WIDTH),
+                _mm_xor_si128(sums[v], indexBits));
+        }
+        foldLanes<PERIOD>(lanes, WIDTH * GROUP_VECTORS, buckets);
+    }
+    foldRemainder<PERIOD>(name, first + groups * WIDTH * GROUP_VECTORS, buckets);
+}
+
+//****************************************************************************//
+
+//Whole 32-byte groups, then whatever still fills a 16-byte group, then single steps
+template <int PERIOD>
+__attribute__((target("avx2")))
+void foldNameAvx2(const string& name, char* buckets)
+{
+    static const int WIDTH = 32;
+    //Wider vectors only pay off for names that fill several groups
+    static const size_t MIN_GROUPS = 4;
+    const size_t groups = name.size() * OUT_SIZE / (WIDTH * GROUP_VECTORS);
+    if (groups < MIN_GROUPS) {
+        foldNameSse2<PERIOD>(name, buckets);
+        return;
+    }
+    const RepeatedName repeated(name, WIDTH);
+    const size_t step = WIDTH % name.size();
+    __m256i sums[GROUP_VECTORS];
+    for (int v = 0; v < GROUP_VECTORS; v++) {
+        sums[v] = _mm256_setzero_si256();
+    }
+    size_t position = 0;
+    for (size_t group = 0; group < groups; group++) {
+        for (int v = 0; v < GROUP_VECTORS; v++) {
+            sums[v] = _mm256_xor_si256(sums[v], _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(repeated.data + position)));
+            position += step;
+            if (position >= name.size()) {
+                position -= name.size();
+            }
+        }
+    }
+    const __m256i indexBits = (groups % 2 == 1) ?
+        _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15) :
+        _mm256_setzero_si256();
+    alignas(32) char lanes[WIDTH * GROUP_VECTORS];
+    for (int v = 0; v < GROUP_VECTORS; v++) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes + v * WIDTH),
+            _mm256_xor_si256(sums[v], indexBits));
+    }
+    foldLanes<PERIOD>(lanes, WIDTH * GROUP_VECTORS, buckets);
+    foldNameSse2<PERIOD>(name, buckets, groups * WIDTH * GROUP_VECTORS);
+}
+
+//****************************************************************************//
+
+string hashSse2(int key, const string& value1, const string& value2)
+{
+    char firstBuckets[HALF_SIZE] = {0};
+    char secondBuckets[OUT_SIZE] = {0};
+    foldNameSse2<HALF_SIZE>(value1, firstBuckets);
+    foldNameSse2<OUT_SIZE>(value2, secondBuckets);
+    return finishDigest(key, firstBuckets, secondBuckets);
+}
+
+//****************************************************************************//
+
+string hashAvx2(int key, const string& value1, const string& value2)
+{
+    char firstBuckets[HALF_SIZE] = {0};
+    char secondBuckets[OUT_SIZE] = {0};
+    foldNameAvx2<HALF_SIZE>(value1, firstBuckets);
+    foldNameAvx2<OUT_SIZE>(value2, secondBuckets);
+    return finishDigest(key, firstBuckets, secondBuckets);
+}
+
+//****************************************************************************//
+
+bool hashAvx2Supported()
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+#else
+
+//****************************************************************************//
+
+string hashSse2(int key, const string& value1, const string& value2)
+{
+    return hashScalar(key, value1, value2);
+}
+
+string hashAvx2(int key, const string& value1, const string& value2)
+{
+    return hashScalar(key, value1, value2);
+}
+
+bool hashAvx2Supported()
+{
+    return false;
+}
+
+#endif
+
+//****************************************************************************//
+
+HashKernel hashBestKernel()
+{
+#ifdef HASH_KERNELS_X86
+    static const HashKernel best = hashAvx2Supported() ? hashAvx2 : hashSse2;
+    return best;
+#else
+    return hashScalar;
+#endif
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+
+using std::string;
+
+
+/**
+ * HashKernel - A function computing the same digest as hash()
+*/
+typedef string (*HashKernel)(int key, const string& value1, const string& value2);
+
+
+/**
+ * hashScalar - The original, one byte at a time, implementation of hash()
+*/
+string hashScalar(int key, const string& value1, const string& value2);
+
+
+/**
+ * hashSse2 - hash() using 16-byte SSE2 vectors, scalar where SSE2 is not available
+*/
+string hashSse2(int key, const string& value1, const string& value2);
+
+
+/**
+ * hashAvx2 - hash() using 32-byte AVX2 vectors, only valid on CPUs that support AVX2
+*/
+string hashAvx2(int key, const string& value1, const string& value2);
+
+
+/**
+ * hashAvx2Supported - returns true if hashAvx2 may run on this CPU
+*/
+bool hashAvx2Supported();
+
+
+/**
+ * hashBestKernel - returns the fastest kernel the running CPU supports
+*/
+HashKernel hashBestKernel();
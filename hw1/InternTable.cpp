@@ -0,0 +1,62 @@
+#include <stdexcept>
+
+#include "InternTable.h"
+
+//****************************************************************************//
+
+InternTable::InternTable() : count(0)
+{
+    InternTableIntern(*this, "");
+}
+
+//****************************************************************************//
+
+unsigned int InternTableIntern(InternTable& table, const std::string_view value)
+{
+    std::lock_guard<std::mutex> lock(table.mutex);
+    const auto found = table.ids.find(value);
+    if (found != table.ids.end()) {
+        return found->second;
+    }
+    const unsigned int id = table.count.load(std::memory_order_relaxed);
+    const unsigned int chunk = id / InternTable::CHUNK_SIZE;
+    if (chunk == InternTable::MAX_CHUNKS) {
+        throw std::length_error("InternTable is full");
+    }
+    if (!table.chunks[chunk]) {
+        table.chunks[chunk].reset(new string[InternTable::CHUNK_SIZE]);
+    }
+    string& stored = table.chunks[chunk][id % InternTable::CHUNK_SIZE];
+    stored = value;
+    table.ids.emplace(stored, id);
+    table.count.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+//****************************************************************************//
+
+bool InternTableFind(InternTable& table, const std::string_view value,
+    unsigned int& id)
+{
+    std::lock_guard<std::mutex> lock(table.mutex);
+    const auto found = table.ids.find(value);
+    if (found == table.ids.end()) {
+        return false;
+    }
+    id = found->second;
+    return true;
+}
+
+//****************************************************************************//
+
+const string& InternTableName(const InternTable& table, const unsigned int id)
+{
+    return table.chunks[id / InternTable::CHUNK_SIZE][id % InternTable::CHUNK_SIZE];
+}
+
+//****************************************************************************//
+
+unsigned int InternTableSize(const InternTable& table)
+{
+    return table.count.load(std::memory_order_acquire);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using std::string;
+
+
+/**
+*
+ * InternTable - Stores every distinct string once and gives it a small id
+ *
+ * Ids are dense and handed out in order of first appearance, the empty
+ * string always being id 0. Stored strings never move, so the references
+ * returned by InternTableName stay valid for the lifetime of the table.
+ *
+ * Interning and lookups by string may run from several threads at once.
+ * Lookups by id take no lock: an id can only be obtained after its string
+ * has been stored.
+ *
+*/
+struct InternTable {
+
+      static const unsigned int CHUNK_SIZE = 4096;
+      static const unsigned int MAX_CHUNKS = 16384;
+
+      std::mutex mutex;
+      std::unordered_map<std::string_view, unsigned int> ids;
+      std::unique_ptr<string[]> chunks[MAX_CHUNKS];
+      std::atomic<unsigned int> count;
+
+      InternTable();
+      InternTable(const InternTable&) = delete;
+      InternTable& operator=(const InternTable&) = delete;
+};
+
+
+/**
+ * InternTableIntern - returns the id of a string, storing it first if it is new
+ *
+ * @param table Table to intern into
+ * @param value String to intern
+ *
+ * @return The id of the string
+*/
+unsigned int InternTableIntern(InternTable& table, std::string_view value);
+
+
+/**
+ * InternTableFind - looks up the id of a string without storing it
+ *
+ * @param table Table to search
+ * @param value String to look for
+ * @param id Set to the id of the string when it is found
+ *
+ * @return true if the string was interned before, false otherwise
+*/
+bool InternTableFind(InternTable& table, std::string_view value, unsigned int& id);
+
+
+/**
+ * InternTableName - returns the string stored under a given id
+ *
+ * @param table Table the id belongs to
+ * @param id Id returned by InternTableIntern
+ *
+ * @return The stored string
+*/
+const string& InternTableName(const InternTable& table, unsigned int id);
+
+
+/**
+ * InternTableSize - returns the number of distinct strings in the table
+ *
+ * @param table Table to measure
+ *
+ * @return Number of ids handed out so far, including the empty string
+*/
+unsigned int InternTableSize(const InternTable& table);
@@ -0,0 +1,129 @@
+#include "Ledger.h"
+#include "BlockChain.h"
+#include "AccountIndex.h"
+#include "MerkleTree.h"
+#include "TimeIndex.h"
+
+//****************************************************************************//
+
+Ledger::Ledger() : used(0), tail(nullptr), count(0), index(nullptr), merkle(nullptr),
+    log(nullptr), times(nullptr)
+{
+    tail = LedgerNewBlock(*this);
+}
+
+//****************************************************************************//
+
+Ledger::~Ledger() = default;
+
+//****************************************************************************//
+
+BlockChain& LedgerHead(Ledger& ledger)
+{
+    return ledger.chunks.front()[0];
+}
+
+//****************************************************************************//
+
+BlockChain* LedgerNewBlock(Ledger& ledger)
+{
+    if (ledger.chunks.empty() || ledger.used == Ledger::CHUNK_SIZE) {
+        ledger.chunks.emplace_back(new BlockChain[Ledger::CHUNK_SIZE]());
+        ledger.used = 0;
+    }
+    BlockChain* block = &ledger.chunks.back()[ledger.used++];
+    block->next = nullptr;
+    block->ledger = &ledger;
+    return block;
+}
+
+//****************************************************************************//
+
+BlockChain& LedgerTail(Ledger& ledger)
+{
+    return *ledger.tail;
+}
+
+//****************************************************************************//
+
+int LedgerSize(const Ledger& ledger)
+{
+    return ledger.count;
+}
+
+//****************************************************************************//
+
+void LedgerClear(Ledger& ledger)
+{
+    ledger.chunks.clear();
+    ledger.used = 0;
+    ledger.tail = LedgerNewBlock(ledger);
+    ledger.count = 0;
+    if (ledger.index != nullptr) {
+        AccountIndexClear(*ledger.index);
+    }
+    if (ledger.merkle != nullptr) {
+        ledger.merkle->levels.clear();
+    }
+    if (ledger.times != nullptr) {
+        TimeIndexBuild(*ledger.times, LedgerHead(ledger));
+    }
+}
+
+//****************************************************************************//
+
+void LedgerAdopt(Ledger& ledger, Ledger& other)
+{
+    if (other.chunks.empty()) {
+        return;
+    }
+    for (std::unique_ptr<BlockChain[]>& chunk : other.chunks) {
+        ledger.chunks.push_back(std::move(chunk));
+    }
+    ledger.used = other.used;
+    other.chunks.clear();
+    other.used = 0;
+}
+
+//****************************************************************************//
+
+void LedgerAttachIndex(Ledger& ledger, AccountIndex* index)
+{
+    ledger.index = index;
+    if (index == nullptr) {
+        return;
+    }
+    AccountIndexClear(*index);
+    for (const BlockChain* current = &LedgerHead(ledger);
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next) {
+        AccountIndexAdd(*index, current->transaction);
+    }
+}
+
+//****************************************************************************//
+
+void LedgerAttachMerkle(Ledger& ledger, MerkleTree* merkle)
+{
+    ledger.merkle = merkle;
+    if (merkle != nullptr) {
+        MerkleTreeBuild(*merkle, LedgerHead(ledger));
+    }
+}
+
+//****************************************************************************//
+
+void LedgerAttachLog(Ledger& ledger, TransactionLog* log)
+{
+    ledger.log = log;
+}
+
+//****************************************************************************//
+
+void LedgerAttachTimes(Ledger& ledger, TimeIndex* times)
+{
+    ledger.times = times;
+    if (times != nullptr) {
+        TimeIndexBuild(*times, LedgerHead(ledger));
+    }
+}
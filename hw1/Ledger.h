@@ -0,0 +1,159 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+struct BlockChain;
+struct AccountIndex;
+struct MerkleTree;
+struct TransactionLog;
+struct TimeIndex;
+
+
+/**
+*
+ * Ledger - Owns the Blocks of one BlockChain
+ *
+ * Blocks are carved out of fixed-size chunks in the order they are created.
+ * The loaders create them from the head to the tail, so a loaded chain lies
+ * in memory in chain order and is walked sequentially. Appending at the head
+ * moves the old head into a new Block, so the appended part of a chain runs
+ * backwards in memory. Blocks are never freed one by one: all of them are
+ * released together when the Ledger is cleared or destroyed.
+ *
+ * The first Block of the first chunk is the head of the chain. The Ledger
+ * is also the handle of that chain: it tracks the tail and the number of
+ * Blocks, which the BlockChain functions keep up to date, so appending and
+ * measuring the chain take constant time.
+ *
+ * A Ledger may carry an AccountIndex, which the BlockChain functions keep in
+ * step with the chain whenever they add Blocks or change values. It may
+ * likewise carry a MerkleTree digest of the chain, a TimeIndex over its
+ * timestamps, and a TransactionLog that records every transaction appended
+ * at the head.
+ *
+*/
+struct Ledger {
+
+      static const int CHUNK_SIZE = 4096;
+
+      std::vector<std::unique_ptr<BlockChain[]>> chunks;
+      int used;
+      BlockChain* tail;
+      int count;
+      AccountIndex* index;
+      MerkleTree* merkle;
+      TransactionLog* log;
+      TimeIndex* times;
+
+      Ledger();
+      Ledger(const Ledger&) = delete;
+      Ledger& operator=(const Ledger&) = delete;
+      ~Ledger();
+};
+
+
+/**
+ * LedgerHead - returns the head Block of the chain owned by the Ledger
+ *
+ * @param ledger Ledger that owns the chain
+ *
+ * @return The head Block (empty if nothing was added yet)
+*/
+BlockChain& LedgerHead(Ledger& ledger);
+
+
+/**
+ * LedgerNewBlock - takes a fresh, empty Block from the Ledger
+ *
+ * @param ledger Ledger to allocate from
+ *
+ * @return Pointer to the new Block, owned by the Ledger
+*/
+BlockChain* LedgerNewBlock(Ledger& ledger);
+
+
+/**
+ * LedgerTail - returns the last Block of the chain owned by the Ledger
+ *
+ * @param ledger Ledger that owns the chain
+ *
+ * @return The tail Block, which is the head while the chain is empty
+*/
+BlockChain& LedgerTail(Ledger& ledger);
+
+
+/**
+ * LedgerSize - returns the number of Blocks in the chain owned by the Ledger
+ *
+ * @param ledger Ledger that owns the chain
+*/
+int LedgerSize(const Ledger& ledger);
+
+
+/**
+ * LedgerClear - releases every Block of the Ledger at once and leaves it
+ * holding a single empty head
+ *
+ * @param ledger Ledger to clear
+*/
+void LedgerClear(Ledger& ledger);
+
+
+/**
+ * LedgerAttachIndex - attaches an AccountIndex to the Ledger and fills it from
+ * the chain the Ledger currently holds
+ *
+ * @param ledger Ledger to attach to
+ * @param index Index to maintain from now on, or nullptr to detach the current one
+*/
+void LedgerAttachIndex(Ledger& ledger, AccountIndex* index);
+
+
+/**
+ * LedgerAttachMerkle - attaches a MerkleTree to the Ledger and builds it from
+ * the chain the Ledger currently holds
+ *
+ * @param ledger Ledger to attach to
+ * @param merkle Tree to maintain from now on, or nullptr to detach the current one
+*/
+void LedgerAttachMerkle(Ledger& ledger, MerkleTree* merkle);
+
+
+/**
+ * LedgerAttachLog - attaches a TransactionLog that records the appends from now on
+ *
+ * Nothing already in the chain is logged, so a chain recovered with
+ * TransactionLogReplay must be replayed before its log is attached again.
+ *
+ * @param ledger Ledger to attach to
+ * @param log Open log to append to, or nullptr to detach the current one
+*/
+void LedgerAttachLog(Ledger& ledger, TransactionLog* log);
+
+
+/**
+ * LedgerAdopt - moves every chunk of another Ledger to the end of this one
+ *
+ * Blocks keep their addresses, so chains built in the other Ledger stay
+ * linked. The Blocks must already name `ledger` as their owner, and `other`
+ * may only be destroyed or cleared afterwards. New Blocks are taken from the
+ * last adopted chunk; whatever was left of the earlier chunks stays unused.
+ *
+ * @param ledger Ledger to move the chunks into
+ * @param other Ledger to take the chunks from
+*/
+void LedgerAdopt(Ledger& ledger, Ledger& other);
+
+
+/**
+ * LedgerAttachTimes - attaches a TimeIndex to the Ledger and builds it from
+ * the chain the Ledger currently holds
+ *
+ * Once a transaction is appended out of time order the index goes stale, and
+ * windowed queries scan the chain until it is attached again.
+ *
+ * @param ledger Ledger to attach to
+ * @param times Index to maintain from now on, or nullptr to detach the current one
+*/
+void LedgerAttachTimes(Ledger& ledger, TimeIndex* times);
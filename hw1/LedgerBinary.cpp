@@ -0,0 +1,86 @@
+#include <cstring>
+
+#include "LedgerBinary.h"
+
+//The structs are copied to and from the file as they are, which assumes a little-endian host
+static_assert(sizeof(LedgerBinaryHeader) == 32, "LedgerBinaryHeader must have no padding");
+static_assert(sizeof(LedgerBinaryRecord) == 16, "LedgerBinaryRecord must have no padding");
+
+//****************************************************************************//
+
+bool LedgerBinaryCheckHeader(const LedgerBinaryHeader& header, const uint64_t size)
+{
+    if (size < sizeof(LedgerBinaryHeader) ||
+        std::memcmp(header.magic, LEDGER_BINARY_MAGIC, sizeof(LEDGER_BINARY_MAGIC)) != 0 ||
+        header.version != LEDGER_BINARY_VERSION) {
+        return false;
+    }
+    //Every section must fit in what is left, checked one at a time so nothing overflows
+    uint64_t left = size - sizeof(LedgerBinaryHeader);
+    const uint64_t nameSizesSize = uint64_t(header.nameCount) * sizeof(uint32_t);
+    if (nameSizesSize > left) {
+        return false;
+    }
+    left -= nameSizesSize;
+    const uint64_t namesSize = header.namesSize + LedgerBinaryPadding(header.namesSize);
+    if (namesSize > left) {
+        return false;
+    }
+    left -= namesSize;
+    if (header.blockCount > left / sizeof(LedgerBinaryRecord)) {
+        return false;
+    }
+    left -= header.blockCount * sizeof(LedgerBinaryRecord);
+    return header.timestampsSize == left;
+}
+
+//****************************************************************************//
+
+bool LedgerBinaryOpen(const char* data, const size_t size, LedgerBinaryView& view)
+{
+    if (size < sizeof(LedgerBinaryHeader)) {
+        return false;
+    }
+    std::memcpy(&view.header, data, sizeof(LedgerBinaryHeader));
+    const LedgerBinaryHeader& header = view.header;
+    if (!LedgerBinaryCheckHeader(header, size)) {
+        return false;
+    }
+    const size_t nameSizesSize = header.nameCount * sizeof(uint32_t);
+    const size_t namesSize = header.namesSize + LedgerBinaryPadding(header.namesSize);
+    view.nameSizes = data + sizeof(LedgerBinaryHeader);
+    view.names = view.nameSizes + nameSizesSize;
+    view.records = view.names + namesSize;
+    view.timestamps = view.records + header.blockCount * sizeof(LedgerBinaryRecord);
+
+    uint64_t totalNameSize = 0;
+    for (uint32_t name = 0; name < header.nameCount; name++) {
+        totalNameSize += LedgerBinaryNameSize(view, name);
+    }
+    return totalNameSize == header.namesSize;
+}
+
+//****************************************************************************//
+
+size_t LedgerBinaryPadding(const size_t namesSize)
+{
+    return (sizeof(uint32_t) - namesSize % sizeof(uint32_t)) % sizeof(uint32_t);
+}
+
+//****************************************************************************//
+
+uint32_t LedgerBinaryNameSize(const LedgerBinaryView& view, const uint32_t name)
+{
+    uint32_t size;
+    std::memcpy(&size, view.nameSizes + name * sizeof(uint32_t), sizeof(size));
+    return size;
+}
+
+//****************************************************************************//
+
+LedgerBinaryRecord LedgerBinaryRecordAt(const LedgerBinaryView& view, const uint64_t record)
+{
+    LedgerBinaryRecord result;
+    std::memcpy(&result, view.records + record * sizeof(LedgerBinaryRecord), sizeof(result));
+    return result;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+*
+ * Binary ledger format, version 1
+ *
+ * All integers are little-endian. The file holds, in this order:
+ *
+ *   LedgerBinaryHeader
+ *   nameCount uint32 lengths of the names in the dictionary
+ *   the names, back to back, padded with zeros to a multiple of 4 bytes
+ *   blockCount LedgerBinaryRecord, head first
+ *   the timestamps of the records, back to back
+ *
+ * Records refer to the sender and the receiver by their position in the
+ * dictionary, so every name is stored (and interned on load) only once.
+ *
+*/
+static const char LEDGER_BINARY_MAGIC[4] = {'H', 'W', '1', 'L'};
+static const uint32_t LEDGER_BINARY_VERSION = 1;
+
+struct LedgerBinaryHeader {
+
+      char magic[4];
+      uint32_t version;
+      uint32_t nameCount;
+      uint32_t namesSize;
+      uint64_t blockCount;
+      uint64_t timestampsSize;
+};
+
+struct LedgerBinaryRecord {
+
+      uint32_t sender;
+      uint32_t receiver;
+      uint32_t value;
+      uint32_t timestampSize;
+};
+
+
+/**
+*
+ * LedgerBinaryView - The sections of a binary ledger held in memory
+ *
+*/
+struct LedgerBinaryView {
+
+      LedgerBinaryHeader header;
+      const char* nameSizes;
+      const char* names;
+      const char* records;
+      const char* timestamps;
+};
+
+
+/**
+ * LedgerBinaryCheckHeader - checks a header against the size of the ledger it starts
+ *
+ * @param header Header of the ledger
+ * @param size Size of the whole ledger, header included
+ *
+ * @return true if the header is of a known version and its sections add up to the size,
+ *         false otherwise
+*/
+bool LedgerBinaryCheckHeader(const LedgerBinaryHeader& header, uint64_t size);
+
+
+/**
+ * LedgerBinaryOpen - checks the header of a binary ledger and locates its sections
+ *
+ * @param data Start of the buffer
+ * @param size Size of the buffer
+ * @param view Filled with the sections of the ledger
+ *
+ * @return true if the buffer holds a whole ledger of a known version, false otherwise
+*/
+bool LedgerBinaryOpen(const char* data, size_t size, LedgerBinaryView& view);
+
+
+/**
+ * LedgerBinaryPadding - returns the zeros needed after the names to align the records
+ *
+ * @param namesSize Total size of the names
+*/
+size_t LedgerBinaryPadding(size_t namesSize);
+
+
+/**
+ * LedgerBinaryNameSize - returns the size of the name at a given position of the dictionary
+*/
+uint32_t LedgerBinaryNameSize(const LedgerBinaryView& view, uint32_t name);
+
+
+/**
+ * LedgerBinaryRecordAt - returns the record at a given position, the head at 0
+*/
+LedgerBinaryRecord LedgerBinaryRecordAt(const LedgerBinaryView& view, uint64_t record);
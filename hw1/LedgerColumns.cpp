@@ -0,0 +1,185 @@
+#include <algorithm>
+
+#include "LedgerColumns.h"
+#include "AccountIndex.h"
+#include "BlockChain.h"
+
+//  The aggregations sum into LANES independent accumulators over blocks of
+//  LANES rows: a loop with a fixed trip count is vectorized even at -O2,
+//  where a plain reduction over the whole column is not.
+
+static const int LANES = 16;
+
+//****************************************************************************//
+
+void LedgerColumnsFromChain(LedgerColumns& columns, const BlockChain& blockChain)
+{
+    columns.values.clear();
+    columns.senders.clear();
+    columns.receivers.clear();
+    columns.timestamps.clear();
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next) {
+        columns.values.push_back(current->transaction.value);
+        columns.senders.push_back(current->transaction.sender.id);
+        columns.receivers.push_back(current->transaction.receiver.id);
+        columns.timestamps.push_back(current->timestamp.id);
+    }
+}
+
+//****************************************************************************//
+
+BlockChain& LedgerColumnsToChain(const LedgerColumns& columns, Ledger& ledger)
+{
+    LedgerClear(ledger);
+    BlockChain& blockChain = LedgerHead(ledger);
+    //Rows are linked in order from the head, like a loaded chain, so the Blocks follow each
+    //other in memory and no append hook runs once per row
+    BlockChain* tail = nullptr;
+    const int size = LedgerColumnsSize(columns);
+    for (int row = 0; row < size; row++) {
+        BlockChain* block = tail == nullptr ? &blockChain : LedgerNewBlock(ledger);
+        block->transaction.value = columns.values[row];
+        block->transaction.sender.id = columns.senders[row];
+        block->transaction.receiver.id = columns.receivers[row];
+        block->timestamp = LedgerColumnsTimestamp(columns, row);
+        if (tail != nullptr) {
+            tail->next = block;
+        }
+        tail = block;
+        if (ledger.index != nullptr) {
+            AccountIndexAdd(*ledger.index, block->transaction);
+        }
+    }
+    ledger.tail = tail != nullptr ? tail : &blockChain;
+    ledger.count = size;
+    BlockChainValuesChanged(blockChain);
+    return blockChain;
+}
+
+//****************************************************************************//
+
+int LedgerColumnsSize(const LedgerColumns& columns)
+{
+    return columns.values.size();
+}
+
+//****************************************************************************//
+
+Timestamp LedgerColumnsTimestamp(const LedgerColumns& columns, const int row)
+{
+    Timestamp timestamp;
+    timestamp.id = columns.timestamps[row];
+    return timestamp;
+}
+
+//****************************************************************************//
+
+int LedgerColumnsBalance(const LedgerColumns& columns, const AccountName account)
+{
+    const unsigned int* values = columns.values.data();
+    const unsigned int* senders = columns.senders.data();
+    const unsigned int* receivers = columns.receivers.data();
+    const unsigned int id = account.id;
+    const int size = LedgerColumnsSize(columns);
+    //Masks the values instead of branching on the ids, one lane per column of a row block
+    const auto change = [=](const int row) {
+        return (values[row] & (0u - (receivers[row] == id))) -
+            (values[row] & (0u - (senders[row] == id)));
+    };
+    unsigned int lanes[LANES] = {0};
+    int row = 0;
+    for (; row + LANES <= size; row += LANES) {
+        for (int lane = 0; lane < LANES; lane++) {
+            lanes[lane] += change(row + lane);
+        }
+    }
+    unsigned int balance = 0;
+    for (int lane = 0; lane < LANES; lane++) {
+        balance += lanes[lane];
+    }
+    for (; row < size; row++) {
+        balance += change(row);
+    }
+    return static_cast<int>(balance);
+}
+
+//****************************************************************************//
+
+std::vector<AccountBalance> LedgerColumnsBalances(const LedgerColumns& columns)
+{
+    std::vector<unsigned int> balances(InternTableSize(AccountNames()), 0);
+    std::vector<bool> present(balances.size(), false);
+    const int size = LedgerColumnsSize(columns);
+    for (int row = 0; row < size; row++) {
+        balances[columns.receivers[row]] += columns.values[row];
+        balances[columns.senders[row]] -= columns.values[row];
+    }
+    for (int row = 0; row < size; row++) {
+        present[columns.receivers[row]] = true;
+        present[columns.senders[row]] = true;
+    }
+    std::vector<AccountBalance> result;
+    for (unsigned int id = 0; id < balances.size(); id++) {
+        if (present[id]) {
+            AccountName account;
+            account.id = id;
+            result.push_back({account, static_cast<int>(balances[id])});
+        }
+    }
+    return result;
+}
+
+//****************************************************************************//
+
+unsigned long long LedgerColumnsVolume(const LedgerColumns& columns)
+{
+    const unsigned int* values = columns.values.data();
+    const int size = LedgerColumnsSize(columns);
+    unsigned long long lanes[LANES] = {0};
+    int row = 0;
+    for (; row + LANES <= size; row += LANES) {
+        for (int lane = 0; lane < LANES; lane++) {
+            lanes[lane] += values[row + lane];
+        }
+    }
+    unsigned long long volume = 0;
+    for (int lane = 0; lane < LANES; lane++) {
+        volume += lanes[lane];
+    }
+    for (; row < size; row++) {
+        volume += values[row];
+    }
+    return volume;
+}
+
+//****************************************************************************//
+
+std::vector<AccountVolume> LedgerColumnsTopSenders(const LedgerColumns& columns,
+    const int count)
+{
+    std::vector<unsigned long long> volumes(InternTableSize(AccountNames()), 0);
+    std::vector<bool> present(volumes.size(), false);
+    const int size = LedgerColumnsSize(columns);
+    for (int row = 0; row < size; row++) {
+        volumes[columns.senders[row]] += columns.values[row];
+        present[columns.senders[row]] = true;
+    }
+    std::vector<AccountVolume> senders;
+    for (unsigned int id = 0; id < volumes.size(); id++) {
+        if (present[id]) {
+            AccountName account;
+            account.id = id;
+            senders.push_back({account, volumes[id]});
+        }
+    }
+    const auto isBefore = [](const AccountVolume& lhs, const AccountVolume& rhs) {
+        return lhs.volume != rhs.volume ? lhs.volume > rhs.volume :
+            lhs.account.id < rhs.account.id;
+    };
+    const size_t kept = std::min(senders.size(), static_cast<size_t>(std::max(count, 0)));
+    std::partial_sort(senders.begin(), senders.begin() + kept, senders.end(), isBefore);
+    senders.resize(kept);
+    return senders;
+}
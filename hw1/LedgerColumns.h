@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vector>
+
+#include "AccountIndex.h"
+#include "Transaction.h"
+
+struct BlockChain;
+struct Ledger;
+
+
+/**
+*
+ * LedgerColumns - A BlockChain laid out as one array per field
+ *
+ * Row i holds the Block of rank i + 1, the head being row 0. Accounts and
+ * timestamps are stored as their AccountName and Timestamp ids, so the
+ * aggregations below stream over integer arrays only, in loops the compiler
+ * can vectorize.
+ *
+*/
+struct LedgerColumns {
+
+      std::vector<unsigned int> values;
+      std::vector<unsigned int> senders;
+      std::vector<unsigned int> receivers;
+      std::vector<unsigned int> timestamps;
+};
+
+
+/**
+*
+ * AccountVolume - An account together with the total value it sent
+ *
+*/
+struct AccountVolume {
+
+      AccountName account;
+      unsigned long long volume;
+};
+
+
+/**
+ * LedgerColumnsFromChain - fills the columns with every Block of a chain
+ *
+ * @param columns Columns to fill, their previous rows are dropped
+ * @param blockChain Head of the chain
+*/
+void LedgerColumnsFromChain(LedgerColumns& columns, const BlockChain& blockChain);
+
+
+/**
+ * LedgerColumnsToChain - builds a chain from the columns in the given Ledger
+ *
+ * Row 0 becomes the head, and the structures attached to the Ledger are
+ * brought up to date once the whole chain is in place.
+ *
+ * @param columns Columns to read
+ * @param ledger Ledger that will own the Blocks, its previous chain is cleared
+ *
+ * @return The head of the new chain
+*/
+BlockChain& LedgerColumnsToChain(const LedgerColumns& columns, Ledger& ledger);
+
+
+/**
+ * LedgerColumnsSize - returns the number of rows
+*/
+int LedgerColumnsSize(const LedgerColumns& columns);
+
+
+/**
+ * LedgerColumnsTimestamp - returns the timestamp of a row
+*/
+Timestamp LedgerColumnsTimestamp(const LedgerColumns& columns, int row);
+
+
+/**
+ * LedgerColumnsBalance - returns the balance of one account, as BlockChainPersonalBalance does
+ *
+ * @param columns Columns to sum over
+ * @param account Account to sum
+*/
+int LedgerColumnsBalance(const LedgerColumns& columns, AccountName account);
+
+
+/**
+ * LedgerColumnsBalances - returns the balance of every account, as BlockChainAllBalances does
+ *
+ * @param columns Columns to sum over
+ *
+ * @return The balances in increasing order of AccountName id
+*/
+std::vector<AccountBalance> LedgerColumnsBalances(const LedgerColumns& columns);
+
+
+/**
+ * LedgerColumnsVolume - returns the total value of every transaction
+*/
+unsigned long long LedgerColumnsVolume(const LedgerColumns& columns);
+
+
+/**
+ * LedgerColumnsTopSenders - returns the accounts that sent the most value
+ *
+ * @param columns Columns to sum over
+ * @param count Number of accounts to return at most
+ *
+ * @return The accounts by decreasing volume, ties by increasing AccountName id
+*/
+std::vector<AccountVolume> LedgerColumnsTopSenders(const LedgerColumns& columns, int count);
@@ -0,0 +1,92 @@
+#include <limits>
+
+#include "LedgerParser.h"
+
+//****************************************************************************//
+
+//Same set of characters `ifstream >>` treats as separators
+inline bool isSeparator(const char character)
+{
+    return character == ' ' || character == '\n' || character == '\t' ||
+        character == '\r' || character == '\v' || character == '\f';
+}
+
+//****************************************************************************//
+
+inline void skipSeparators(LedgerScanner& scanner)
+{
+    while (scanner.position != scanner.end && isSeparator(*scanner.position)) {
+        scanner.position++;
+    }
+}
+
+//****************************************************************************//
+
+bool readWord(LedgerScanner& scanner, std::string_view& word)
+{
+    skipSeparators(scanner);
+    const char* start = scanner.position;
+    while (scanner.position != scanner.end && !isSeparator(*scanner.position)) {
+        scanner.position++;
+    }
+    word = std::string_view(start, scanner.position - start);
+    return !word.empty();
+}
+
+//****************************************************************************//
+
+//Reads an optionally signed decimal number the way `ifstream >> unsigned int` does
+bool readValue(LedgerScanner& scanner, unsigned int& value)
+{
+    skipSeparators(scanner);
+    bool negative = false;
+    if (scanner.position != scanner.end &&
+        (*scanner.position == '-' || *scanner.position == '+')) {
+        negative = *scanner.position == '-';
+        scanner.position++;
+    }
+    const char* start = scanner.position;
+    unsigned long long result = 0;
+    while (scanner.position != scanner.end &&
+        *scanner.position >= '0' && *scanner.position <= '9') {
+        result = result * 10 + (*scanner.position - '0');
+        if (result > std::numeric_limits<unsigned int>::max()) {
+            return false;
+        }
+        scanner.position++;
+    }
+    if (scanner.position == start) {
+        return false;
+    }
+    value = negative ? 0u - static_cast<unsigned int>(result) :
+        static_cast<unsigned int>(result);
+    return true;
+}
+
+//****************************************************************************//
+
+bool LedgerScannerNext(LedgerScanner& scanner, LedgerRecord& record)
+{
+    return readWord(scanner, record.sender) &&
+        readWord(scanner, record.receiver) &&
+        readValue(scanner, record.value) &&
+        readWord(scanner, record.timestamp);
+}
+
+//****************************************************************************//
+
+bool LedgerScannerAtEnd(LedgerScanner& scanner)
+{
+    skipSeparators(scanner);
+    return scanner.position == scanner.end;
+}
+
+//****************************************************************************//
+
+const char* LedgerScannerSafeEnd(const char* begin, const char* end)
+{
+    while (end != begin && !isSeparator(end[-1])) {
+        end--;
+    }
+    return end;
+}
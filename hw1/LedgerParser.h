@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string_view>
+
+
+/**
+*
+ * LedgerRecord - One parsed line of a ledger file
+ *
+ * The strings are views into the parsed buffer and live as long as it does.
+ *
+*/
+struct LedgerRecord {
+
+      std::string_view sender;
+      std::string_view receiver;
+      unsigned int value;
+      std::string_view timestamp;
+};
+
+
+/**
+*
+ * LedgerScanner - Reads "<sender> <receiver> <value> <timestamp>" records
+ * in place from a buffer
+ *
+ * Tokens are separated by any whitespace, exactly as `ifstream >>` reads
+ * them, and scanning stops at the first record that cannot be read whole.
+ *
+*/
+struct LedgerScanner {
+
+      const char* position;
+      const char* end;
+};
+
+
+/**
+ * LedgerScannerNext - reads the next record
+ *
+ * @param scanner Scanner to advance
+ * @param record Filled with the record that was read
+ *
+ * @return true if a whole record was read, false at the end of the input
+*/
+bool LedgerScannerNext(LedgerScanner& scanner, LedgerRecord& record);
+
+
+/**
+ * LedgerScannerAtEnd - skips separators and tells whether any input is left
+ *
+ * @param scanner Scanner to check
+ *
+ * @return true if only separators were left, false otherwise
+*/
+bool LedgerScannerAtEnd(LedgerScanner& scanner);
+
+
+/**
+ * LedgerScannerSafeEnd - finds where a buffer holding the start of a larger input may be cut
+ *
+ * Scanning up to the returned position never cuts a token in two, though a
+ * record may still continue past it.
+ *
+ * @param begin Start of the buffer
+ * @param end End of the buffer
+ *
+ * @return The position just after the last separator, begin if there is none
+*/
+const char* LedgerScannerSafeEnd(const char* begin, const char* end);
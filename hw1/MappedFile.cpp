@@ -0,0 +1,109 @@
+#include <fstream>
+#include <iterator>
+
+#include "MappedFile.h"
+#include "Stats.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_MMAP
+#endif
+
+//****************************************************************************//
+
+MappedFile::MappedFile() : data(nullptr), size(0), isOpen(false), isMapped(false)
+{
+}
+
+//****************************************************************************//
+
+MappedFile::~MappedFile()
+{
+    MappedFileClose(*this);
+}
+
+//****************************************************************************//
+
+//Reads the whole file into the buffer, used when mapping is not available
+bool readWholeFile(MappedFile& file, const string& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open()) {
+        return false;
+    }
+    file.buffer.assign(std::istreambuf_iterator<char>(stream),
+        std::istreambuf_iterator<char>());
+    file.data = file.buffer.data();
+    file.size = file.buffer.size();
+    file.isOpen = true;
+    return true;
+}
+
+//****************************************************************************//
+
+//Maps the file, or reads it when it cannot be mapped
+bool openFile(MappedFile& file, const string& path)
+{
+#ifdef MAPPED_FILE_MMAP
+    const int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+        close(descriptor);
+        return readWholeFile(file, path);
+    }
+    file.size = status.st_size;
+    file.isOpen = true;
+    if (file.size > 0) {
+        void* mapping = mmap(nullptr, file.size, PROT_READ, MAP_PRIVATE,
+            descriptor, 0);
+        if (mapping == MAP_FAILED) {
+            close(descriptor);
+            file.size = 0;
+            file.isOpen = false;
+            return readWholeFile(file, path);
+        }
+        madvise(mapping, file.size, MADV_SEQUENTIAL);
+        file.data = static_cast<const char*>(mapping);
+        file.isMapped = true;
+    }
+    close(descriptor);
+    return true;
+#else
+    return readWholeFile(file, path);
+#endif
+}
+
+//****************************************************************************//
+
+bool MappedFileOpen(MappedFile& file, const string& path)
+{
+    MappedFileClose(file);
+    StatsIoScope io;
+    const bool isOpen = openFile(file, path);
+    if (isOpen) {
+        StatsAddBytesRead(file.size);
+    }
+    return isOpen;
+}
+
+//****************************************************************************//
+
+void MappedFileClose(MappedFile& file)
+{
+#ifdef MAPPED_FILE_MMAP
+    if (file.isMapped) {
+        munmap(const_cast<char*>(file.data), file.size);
+    }
+#endif
+    file.buffer.clear();
+    file.data = nullptr;
+    file.size = 0;
+    file.isOpen = false;
+    file.isMapped = false;
+}
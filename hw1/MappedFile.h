@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using std::string;
+
+
+/**
+*
+ * MappedFile - A read-only view of a whole file
+ *
+ * On POSIX systems the file is memory-mapped, elsewhere it is read into a
+ * buffer. An empty file is a valid, empty view.
+ *
+*/
+struct MappedFile {
+
+      const char* data;
+      size_t size;
+      bool isOpen;
+      bool isMapped;
+      std::vector<char> buffer;
+
+      MappedFile();
+      MappedFile(const MappedFile&) = delete;
+      MappedFile& operator=(const MappedFile&) = delete;
+      ~MappedFile();
+};
+
+
+/**
+ * MappedFileOpen - maps the file at the given path
+ *
+ * @param file MappedFile to fill, any previous mapping is released
+ * @param path Path of the file to map
+ *
+ * @return true if the file could be opened, false otherwise
+*/
+bool MappedFileOpen(MappedFile& file, const string& path);
+
+
+/**
+ * MappedFileClose - releases the mapping
+ *
+ * @param file MappedFile to release
+*/
+void MappedFileClose(MappedFile& file);
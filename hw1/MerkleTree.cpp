@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cstring>
+
+#include "MerkleTree.h"
+#include "BlockChain.h"
+
+//****************************************************************************//
+
+//Leaves and inner nodes are digested with different prefixes, so neither can pose as the other
+static const unsigned char LEAF_PREFIX = 0x00;
+static const unsigned char NODE_PREFIX = 0x01;
+
+Sha256Digest leafDigest(const string& hashedMessage)
+{
+    std::vector<unsigned char> data(1 + hashedMessage.size());
+    data[0] = LEAF_PREFIX;
+    std::memcpy(data.data() + 1, hashedMessage.data(), hashedMessage.size());
+    return sha256(data.data(), data.size());
+}
+
+Sha256Digest nodeDigest(const Sha256Digest& left, const Sha256Digest& right)
+{
+    unsigned char data[1 + 2 * sizeof(Sha256Digest)];
+    data[0] = NODE_PREFIX;
+    std::memcpy(data + 1, left.data(), left.size());
+    std::memcpy(data + 1 + left.size(), right.data(), right.size());
+    return sha256(data, sizeof(data));
+}
+
+//****************************************************************************//
+
+//Recomputes the last node of every level above the given one
+void updateRightEdge(MerkleTree& tree, size_t level)
+{
+    for (; tree.levels[level].size() > 1; level++) {
+        if (level + 1 == tree.levels.size()) {
+            tree.levels.emplace_back();
+        }
+        const std::vector<Sha256Digest>& children = tree.levels[level];
+        std::vector<Sha256Digest>& parents = tree.levels[level + 1];
+        const size_t parent = (children.size() - 1) / 2;
+        const Sha256Digest digest = children.size() % 2 == 0 ?
+            nodeDigest(children[2 * parent], children[2 * parent + 1]) :
+            children[2 * parent];
+        parents.resize(parent + 1);
+        parents[parent] = digest;
+    }
+}
+
+//****************************************************************************//
+
+void MerkleTreeBuild(MerkleTree& tree, const BlockChain& blockChain)
+{
+    tree.levels.assign(1, {});
+    std::vector<Sha256Digest>& leaves = tree.levels[0];
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next) {
+        leaves.push_back(leafDigest(TransactionHashedMessage(current->transaction)));
+    }
+    std::reverse(leaves.begin(), leaves.end());
+    for (size_t level = 0; tree.levels[level].size() > 1; level++) {
+        const std::vector<Sha256Digest>& children = tree.levels[level];
+        std::vector<Sha256Digest> parents((children.size() + 1) / 2);
+        for (size_t i = 0; i < parents.size(); i++) {
+            parents[i] = 2 * i + 1 < children.size() ?
+                nodeDigest(children[2 * i], children[2 * i + 1]) : children[2 * i];
+        }
+        tree.levels.push_back(std::move(parents));
+    }
+}
+
+//****************************************************************************//
+
+void MerkleTreeAppend(MerkleTree& tree, const string& hashedMessage)
+{
+    if (tree.levels.empty()) {
+        tree.levels.emplace_back();
+    }
+    tree.levels[0].push_back(leafDigest(hashedMessage));
+    updateRightEdge(tree, 0);
+}
+
+//****************************************************************************//
+
+int MerkleTreeSize(const MerkleTree& tree)
+{
+    return tree.levels.empty() ? 0 : tree.levels[0].size();
+}
+
+//****************************************************************************//
+
+int MerkleTreeLeafOfRank(const MerkleTree& tree, const int rank)
+{
+    return MerkleTreeSize(tree) - rank;
+}
+
+//****************************************************************************//
+
+Sha256Digest MerkleTreeRoot(const MerkleTree& tree)
+{
+    if (MerkleTreeSize(tree) == 0) {
+        return sha256(nullptr, 0);
+    }
+    return tree.levels.back()[0];
+}
+
+//****************************************************************************//
+
+std::vector<MerkleProofStep> MerkleTreeProve(const MerkleTree& tree, int leaf)
+{
+    std::vector<MerkleProofStep> proof;
+    for (size_t level = 0; level + 1 < tree.levels.size(); level++) {
+        const std::vector<Sha256Digest>& nodes = tree.levels[level];
+        const size_t sibling = leaf ^ 1;
+        if (sibling < nodes.size()) {
+            proof.push_back({nodes[sibling], sibling < static_cast<size_t>(leaf)});
+        }
+        leaf /= 2;
+    }
+    return proof;
+}
+
+//****************************************************************************//
+
+bool MerkleTreeVerifyProof(const Sha256Digest& root, const string& hashedMessage,
+    const std::vector<MerkleProofStep>& proof)
+{
+    Sha256Digest digest = leafDigest(hashedMessage);
+    for (const MerkleProofStep& step : proof) {
+        digest = step.siblingOnLeft ? nodeDigest(step.sibling, digest) :
+            nodeDigest(digest, step.sibling);
+    }
+    return digest == root;
+}
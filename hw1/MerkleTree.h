@@ -0,0 +1,106 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Sha256.h"
+
+using std::string;
+
+struct BlockChain;
+
+
+/**
+*
+ * MerkleTree - A Merkle tree over the per-Block hashed messages of a BlockChain
+ *
+ * Leaf i is the SHA-256 of TransactionHashedMessage of the i-th Block
+ * counted from the *tail* of the chain, which is the order in which
+ * BlockChainAppendTransaction adds them: an append at the head is an append
+ * of a leaf, and updates only the O(log n) nodes on the right edge.
+ * A node without a sibling is carried to the next level unchanged.
+ *
+ * levels[0] holds the leaves, the last level holds the root.
+ *
+*/
+struct MerkleTree {
+
+      std::vector<std::vector<Sha256Digest>> levels;
+};
+
+
+/**
+*
+ * MerkleProofStep - One sibling on the path from a leaf to the root
+ *
+*/
+struct MerkleProofStep {
+
+      Sha256Digest sibling;
+      bool siblingOnLeft;
+};
+
+
+/**
+ * MerkleTreeBuild - rebuilds the tree from every Block of a chain
+ *
+ * @param tree Tree to rebuild
+ * @param blockChain Head of the chain
+*/
+void MerkleTreeBuild(MerkleTree& tree, const BlockChain& blockChain);
+
+
+/**
+ * MerkleTreeAppend - adds one leaf after the last one
+ *
+ * @param tree Tree to update
+ * @param hashedMessage Hashed message of the Block the leaf stands for
+*/
+void MerkleTreeAppend(MerkleTree& tree, const string& hashedMessage);
+
+
+/**
+ * MerkleTreeSize - returns the number of leaves
+*/
+int MerkleTreeSize(const MerkleTree& tree);
+
+
+/**
+ * MerkleTreeLeafOfRank - returns the leaf of the Block at a given rank of the chain
+ *
+ * @param tree Tree built over the chain
+ * @param rank Rank of the Block, from 1 at the head as in BlockChainDump
+ *
+ * @return Index of the leaf
+*/
+int MerkleTreeLeafOfRank(const MerkleTree& tree, int rank);
+
+
+/**
+ * MerkleTreeRoot - returns the root digest, the digest of nothing for an empty tree
+*/
+Sha256Digest MerkleTreeRoot(const MerkleTree& tree);
+
+
+/**
+ * MerkleTreeProve - returns the siblings on the path from a leaf to the root
+ *
+ * @param tree Tree to prove against
+ * @param leaf Index of the leaf
+ *
+ * @return The O(log n) steps of the proof, from the leaf upwards
+*/
+std::vector<MerkleProofStep> MerkleTreeProve(const MerkleTree& tree, int leaf);
+
+
+/**
+ * MerkleTreeVerifyProof - checks that a hashed message belongs to the tree with a given root
+ *
+ * @param root Root digest of the tree
+ * @param hashedMessage Hashed message of the Block to check
+ * @param proof Proof returned by MerkleTreeProve for the Block's leaf
+ *
+ * @return true if the proof leads from the message to the root, false otherwise
+*/
+bool MerkleTreeVerifyProof(const Sha256Digest& root, const string& hashedMessage,
+    const std::vector<MerkleProofStep>& proof);
@@ -0,0 +1,60 @@
+#include <cstring>
+
+#include "OutputBuffer.h"
+#include "Stats.h"
+
+//****************************************************************************//
+
+OutputBuffer::OutputBuffer(std::ostream& file) :
+    file(file), data(CAPACITY), size(0)
+{
+}
+
+//****************************************************************************//
+
+OutputBuffer::~OutputBuffer()
+{
+    OutputBufferFlush(*this);
+}
+
+//****************************************************************************//
+
+void OutputBufferWrite(OutputBuffer& buffer, const std::string_view text)
+{
+    if (buffer.size + text.size() > OutputBuffer::CAPACITY) {
+        OutputBufferFlush(buffer);
+        if (text.size() > OutputBuffer::CAPACITY) {
+            StatsIoScope io;
+            buffer.file.write(text.data(), text.size());
+            return;
+        }
+    }
+    std::memcpy(buffer.data.data() + buffer.size, text.data(), text.size());
+    buffer.size += text.size();
+}
+
+//****************************************************************************//
+
+void OutputBufferWriteNumber(OutputBuffer& buffer, unsigned long long number)
+{
+    char digits[20];
+    int start = sizeof(digits);
+    do {
+        digits[--start] = '0' + number % 10;
+        number /= 10;
+    } while (number != 0);
+    OutputBufferWrite(buffer,
+        std::string_view(digits + start, sizeof(digits) - start));
+}
+
+//****************************************************************************//
+
+void OutputBufferFlush(OutputBuffer& buffer)
+{
+    StatsIoScope io;
+    if (buffer.size > 0) {
+        buffer.file.write(buffer.data.data(), buffer.size);
+        buffer.size = 0;
+    }
+    buffer.file.flush();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+
+/**
+*
+ * OutputBuffer - Collects formatted output in memory and writes it to a
+ * stream in large chunks
+ *
+ * Nothing is flushed line by line: the buffer is written out whenever it
+ * fills up, when OutputBufferFlush is called, and when it is destroyed.
+ *
+*/
+struct OutputBuffer {
+
+      static const size_t CAPACITY = 1 << 20;
+
+      std::ostream& file;
+      std::vector<char> data;
+      size_t size;
+
+      explicit OutputBuffer(std::ostream& file);
+      OutputBuffer(const OutputBuffer&) = delete;
+      OutputBuffer& operator=(const OutputBuffer&) = delete;
+      ~OutputBuffer();
+};
+
+
+/**
+ * OutputBufferWrite - appends text to the buffer
+ *
+ * @param buffer Buffer to append to
+ * @param text Text to append
+*/
+void OutputBufferWrite(OutputBuffer& buffer, std::string_view text);
+
+
+/**
+ * OutputBufferWriteNumber - appends the decimal digits of a number to the buffer
+ *
+ * @param buffer Buffer to append to
+ * @param number Number to append, formatted without any locale
+*/
+void OutputBufferWriteNumber(OutputBuffer& buffer, unsigned long long number);
+
+
+/**
+ * OutputBufferFlush - writes everything buffered so far to the stream
+ *
+ * @param buffer Buffer to flush
+*/
+void OutputBufferFlush(OutputBuffer& buffer);
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+using std::string;
+
+
+typedef std::array<unsigned char, 32> Sha256Digest;
+
+
+/**
+ * sha256 - Computes the SHA-256 digest of a buffer
+ *
+ * @param data Bytes to digest
+ * @param size Number of bytes
+ *
+ * @return The 32-byte digest
+*/
+Sha256Digest sha256(const unsigned char* data, size_t size);
+
+
+/**
+ * sha256Hex - Returns a digest as 64 lowercase hexadecimal characters
+ *
+ * @param digest Digest to print
+*/
+string sha256Hex(const Sha256Digest& digest);
+
+
+/**
+ * sha256FromHex - Parses a digest printed by sha256Hex
+ *
+ * @param hex Text to parse
+ * @param digest Set to the parsed digest
+ *
+ * @return true if the text held exactly one digest, false otherwise
+*/
+bool sha256FromHex(const string& hex, Sha256Digest& digest);
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <iomanip>
+
+#include "Stats.h"
+
+//****************************************************************************//
+
+Stats& GlobalStats()
+{
+    static Stats stats;
+    return stats;
+}
+
+std::atomic<bool> statsEnabled(false);
+
+//****************************************************************************//
+
+void StatsEnable()
+{
+    //Constructed first, so the counters outlive a report registered with atexit afterwards
+    GlobalStats();
+    statsEnabled.store(true, std::memory_order_relaxed);
+}
+
+//****************************************************************************//
+
+void StatsAddBlocks(const long long blocks)
+{
+    if (StatsIsEnabled()) {
+        GlobalStats().blocks.fetch_add(blocks, std::memory_order_relaxed);
+    }
+}
+
+//****************************************************************************//
+
+void StatsAddBytesRead(const long long bytes)
+{
+    if (StatsIsEnabled()) {
+        GlobalStats().bytesRead.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+//****************************************************************************//
+
+void StatsAddBytesWritten(const long long bytes)
+{
+    if (StatsIsEnabled()) {
+        GlobalStats().bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+//****************************************************************************//
+
+//Reads every running total into a phase
+StatsPhase currentTotals()
+{
+    const Stats& stats = GlobalStats();
+    StatsPhase totals;
+    totals.ioSeconds = stats.ioNanoseconds.load(std::memory_order_relaxed) / 1e9;
+    totals.blocks = stats.blocks.load(std::memory_order_relaxed);
+    totals.bytesRead = stats.bytesRead.load(std::memory_order_relaxed);
+    totals.bytesWritten = stats.bytesWritten.load(std::memory_order_relaxed);
+    totals.allocations = stats.allocations.load(std::memory_order_relaxed);
+    return totals;
+}
+
+//****************************************************************************//
+
+void StatsReport(std::ostream& file)
+{
+    const std::ios::fmtflags flags = file.flags();
+    size_t nameWidth = 12;
+    for (const StatsPhase& phase : GlobalStats().phases) {
+        nameWidth = std::max(nameWidth, phase.name.size() + 2);
+    }
+    file << std::left << std::setw(nameWidth) << "phase" << std::right
+        << std::setw(10) << "wall(s)" << std::setw(10) << "cpu(s)" << std::setw(10) << "io(s)"
+        << std::setw(12) << "blocks" << std::setw(14) << "read(B)"
+        << std::setw(14) << "written(B)" << std::setw(14) << "allocations" << std::endl;
+    file << std::fixed << std::setprecision(3);
+    for (const StatsPhase& phase : GlobalStats().phases) {
+        file << std::left << std::setw(nameWidth) << phase.name << std::right
+            << std::setw(10) << phase.wallSeconds << std::setw(10) << phase.cpuSeconds
+            << std::setw(10) << phase.ioSeconds << std::setw(12) << phase.blocks
+            << std::setw(14) << phase.bytesRead << std::setw(14) << phase.bytesWritten
+            << std::setw(14) << phase.allocations << std::endl;
+    }
+    file.flags(flags);
+}
+
+//****************************************************************************//
+
+StatsScope::StatsScope(const char* name) : isRecording(StatsIsEnabled()), cpuStart(0)
+{
+    if (!isRecording) {
+        return;
+    }
+    start = currentTotals();
+    start.name = name;
+    cpuStart = std::clock();
+    wallStart = std::chrono::steady_clock::now();
+}
+
+//****************************************************************************//
+
+StatsScope::~StatsScope()
+{
+    if (!isRecording) {
+        return;
+    }
+    const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wallStart;
+    const StatsPhase end = currentTotals();
+    StatsPhase phase;
+    phase.name = start.name;
+    phase.wallSeconds = wall.count();
+    phase.cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    phase.ioSeconds = end.ioSeconds - start.ioSeconds;
+    phase.blocks = end.blocks - start.blocks;
+    phase.bytesRead = end.bytesRead - start.bytesRead;
+    phase.bytesWritten = end.bytesWritten - start.bytesWritten;
+    phase.allocations = end.allocations - start.allocations;
+    GlobalStats().phases.push_back(phase);
+}
+
+//****************************************************************************//
+
+StatsIoScope::StatsIoScope() : isRecording(StatsIsEnabled())
+{
+    if (isRecording) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+//****************************************************************************//
+
+StatsIoScope::~StatsIoScope()
+{
+    if (!isRecording) {
+        return;
+    }
+    const std::chrono::nanoseconds elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    GlobalStats().ioNanoseconds.fetch_add(elapsed.count(), std::memory_order_relaxed);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+/**
+*
+ * Stats - Counters and timings reported by the --stats flag
+ *
+ * A run is split into consecutive phases (load, then the command). Each
+ * phase records its wall and CPU time, the time spent waiting on I/O, and
+ * the Blocks, bytes and allocations it went through. The counters are
+ * running totals that any thread may add to. Allocations are counted by the
+ * global operator new of StatsAllocator.cpp, which only the program links,
+ * so elsewhere they stay 0. A phase keeps how far they moved while it was
+ * open, so the I/O time of work running on several threads is summed.
+ *
+ * Nothing is recorded unless StatsEnable was called: every entry point
+ * tests a single flag first, and none of them runs per Block.
+ *
+*/
+struct StatsPhase {
+
+      std::string name;
+      double wallSeconds = 0;
+      double cpuSeconds = 0;
+      double ioSeconds = 0;
+      long long blocks = 0;
+      long long bytesRead = 0;
+      long long bytesWritten = 0;
+      long long allocations = 0;
+};
+
+struct Stats {
+
+      std::vector<StatsPhase> phases;
+      std::atomic<long long> ioNanoseconds{0};
+      std::atomic<long long> blocks{0};
+      std::atomic<long long> bytesRead{0};
+      std::atomic<long long> bytesWritten{0};
+      std::atomic<long long> allocations{0};
+};
+
+
+/**
+ * GlobalStats - returns the counters of the process
+*/
+Stats& GlobalStats();
+
+
+//Set by StatsEnable, kept apart from GlobalStats so testing it costs a single load
+extern std::atomic<bool> statsEnabled;
+
+
+/**
+ * StatsEnable - starts recording
+*/
+void StatsEnable();
+
+
+/**
+ * StatsIsEnabled - tells whether anything is being recorded
+*/
+inline bool StatsIsEnabled()
+{
+    return statsEnabled.load(std::memory_order_relaxed);
+}
+
+
+/**
+ * StatsAddBlocks - counts Blocks processed
+*/
+void StatsAddBlocks(long long blocks);
+
+
+/**
+ * StatsAddBytesRead - counts bytes read
+*/
+void StatsAddBytesRead(long long bytes);
+
+
+/**
+ * StatsAddBytesWritten - counts bytes written
+*/
+void StatsAddBytesWritten(long long bytes);
+
+
+/**
+ * StatsReport - prints a table of every phase
+ *
+ * @param file Stream to print to, normally std::cerr
+*/
+void StatsReport(std::ostream& file);
+
+
+/**
+*
+ * StatsScope - Records a phase from its construction to its destruction
+ *
+*/
+struct StatsScope {
+
+      bool isRecording;
+      std::chrono::steady_clock::time_point wallStart;
+      std::clock_t cpuStart;
+      StatsPhase start;
+
+      explicit StatsScope(const char* name);
+      StatsScope(const StatsScope&) = delete;
+      StatsScope& operator=(const StatsScope&) = delete;
+      ~StatsScope();
+};
+
+
+/**
+*
+ * StatsIoScope - Counts the time from its construction to its destruction
+ * as time spent waiting on I/O
+ *
+*/
+struct StatsIoScope {
+
+      bool isRecording;
+      std::chrono::steady_clock::time_point start;
+
+      StatsIoScope();
+      StatsIoScope(const StatsIoScope&) = delete;
+      StatsIoScope& operator=(const StatsIoScope&) = delete;
+      ~StatsIoScope();
+};
@@ -0,0 +1,32 @@
+#include <cstdlib>
+#include <new>
+
+#include "Stats.h"
+
+//  Replaces the global allocation functions to count allocations for --stats.
+//  Only the program links this file: tests and benchmarks keep the default ones.
+
+//****************************************************************************//
+
+//Counts allocations while recording, otherwise only tests the flag
+void* operator new(const size_t size)
+{
+    if (StatsIsEnabled()) {
+        GlobalStats().allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
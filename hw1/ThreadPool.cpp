@@ -0,0 +1,57 @@
+#include "ThreadPool.h"
+
+//****************************************************************************//
+
+//Runs queued tasks until the pool is stopping and nothing is left to run
+void runWorker(ThreadPool& pool)
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(pool.mutex);
+            pool.available.wait(lock, [&pool]() {
+                return pool.stopping || !pool.tasks.empty();
+            });
+            if (pool.tasks.empty()) {
+                return;
+            }
+            task = std::move(pool.tasks.front());
+            pool.tasks.pop_front();
+        }
+        task();
+    }
+}
+
+//****************************************************************************//
+
+ThreadPool::ThreadPool(const int threads) : stopping(false)
+{
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(runWorker, std::ref(*this));
+    }
+}
+
+//****************************************************************************//
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+//****************************************************************************//
+
+void ThreadPoolSubmit(ThreadPool& pool, std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.tasks.push_back(std::move(task));
+    }
+    pool.available.notify_one();
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+*
+ * ThreadPool - A fixed set of worker threads running submitted tasks in
+ * the order they were submitted
+ *
+ * Destroying the pool runs every task still queued and joins the workers.
+ *
+*/
+struct ThreadPool {
+
+      std::vector<std::thread> workers;
+      std::deque<std::function<void()>> tasks;
+      std::mutex mutex;
+      std::condition_variable available;
+      bool stopping;
+
+      explicit ThreadPool(int threads);
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+      ~ThreadPool();
+};
+
+
+/**
+ * ThreadPoolSubmit - queues a task to run on one of the workers
+ *
+ * @param pool Pool to run the task on
+ * @param task Task to run
+*/
+void ThreadPoolSubmit(ThreadPool& pool, std::function<void()> task);
+
+
+/**
+ * ThreadPoolAsync - queues a task and returns a future for its result
+ *
+ * @param pool Pool to run the task on
+ * @param task Callable taking no arguments
+ *
+ * @return Future that becomes ready once the task has run
+*/
+template <typename Task>
+auto ThreadPoolAsync(ThreadPool& pool, Task task) -> std::future<decltype(task())>
+{
+    typedef decltype(task()) Result;
+    const auto packaged = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+    ThreadPoolSubmit(pool, [packaged]() { (*packaged)(); });
+    return packaged->get_future();
+}
@@ -0,0 +1,187 @@
+#include <algorithm>
+
+#include "TimeIndex.h"
+#include "BlockChain.h"
+
+//****************************************************************************//
+
+//Parses up to two digits, returning false if there are none
+bool parseField(std::string_view& text, int& value)
+{
+    value = 0;
+    size_t digits = 0;
+    while (digits < text.size() && digits < 2 && text[digits] >= '0' && text[digits] <= '9') {
+        value = value * 10 + (text[digits] - '0');
+        digits++;
+    }
+    text.remove_prefix(digits);
+    return digits > 0;
+}
+
+//****************************************************************************//
+
+int TimeIndexParse(std::string_view timestamp)
+{
+    static const int MINUTE = 60;
+    static const int HOUR = 60 * MINUTE;
+    int hours;
+    int minutes;
+    int seconds = 0;
+    if (!parseField(timestamp, hours) || timestamp.empty() || timestamp[0] != ':') {
+        return TimeIndex::INVALID_TIME;
+    }
+    timestamp.remove_prefix(1);
+    if (!parseField(timestamp, minutes)) {
+        return TimeIndex::INVALID_TIME;
+    }
+    if (!timestamp.empty()) {
+        if (timestamp[0] != ':') {
+            return TimeIndex::INVALID_TIME;
+        }
+        timestamp.remove_prefix(1);
+        if (!parseField(timestamp, seconds) || !timestamp.empty()) {
+            return TimeIndex::INVALID_TIME;
+        }
+    }
+    if (hours > 23 || minutes > 59 || seconds > 59) {
+        return TimeIndex::INVALID_TIME;
+    }
+    return hours * HOUR + minutes * MINUTE + seconds;
+}
+
+//****************************************************************************//
+
+//Adds a balance change after every indexed change of the account
+void addBalance(TimeIndex& index, const AccountName account, const int time,
+    const unsigned int change)
+{
+    if (account.id >= index.balances.size()) {
+        index.balances.resize(account.id + 1);
+    }
+    std::vector<TimeIndexBalance>& balances = index.balances[account.id];
+    const unsigned int previous = balances.empty() ? 0 : balances.back().balance;
+    balances.push_back({time, previous + change});
+}
+
+//****************************************************************************//
+
+//Adds the balance changes of an entry, entries being added in sorted order
+void addEntry(TimeIndex& index, const TimeIndexEntry& entry)
+{
+    index.entries.push_back(entry);
+    const Transaction& transaction = index.blocks[entry.sequence]->transaction;
+    addBalance(index, transaction.sender, entry.time, 0u - transaction.value);
+    addBalance(index, transaction.receiver, entry.time, transaction.value);
+}
+
+//****************************************************************************//
+
+bool operator<(const TimeIndexEntry& lhs, const TimeIndexEntry& rhs)
+{
+    return lhs.time != rhs.time ? lhs.time < rhs.time : lhs.sequence < rhs.sequence;
+}
+
+//****************************************************************************//
+
+void TimeIndexBuild(TimeIndex& index, const BlockChain& blockChain)
+{
+    index.blocks.clear();
+    index.times.clear();
+    index.entries.clear();
+    index.balances.clear();
+    index.isStale = false;
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next) {
+        index.blocks.push_back(current);
+        index.times.push_back(TimeIndexParse(current->timestamp.text()));
+    }
+    std::reverse(index.blocks.begin(), index.blocks.end());
+    std::reverse(index.times.begin(), index.times.end());
+
+    std::vector<TimeIndexEntry> sorted;
+    sorted.reserve(index.times.size());
+    for (size_t sequence = 0; sequence < index.times.size(); sequence++) {
+        if (index.times[sequence] != TimeIndex::INVALID_TIME) {
+            sorted.push_back({index.times[sequence], static_cast<int>(sequence)});
+        }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    index.entries.reserve(sorted.size());
+    for (const TimeIndexEntry& entry : sorted) {
+        addEntry(index, entry);
+    }
+}
+
+//****************************************************************************//
+
+void TimeIndexAppend(TimeIndex& index, const BlockChain& blockChain)
+{
+    if (index.isStale) {
+        return;
+    }
+    //The previous head moved into the Block after the head
+    if (!index.blocks.empty()) {
+        index.blocks.back() = blockChain.next;
+    }
+    const int sequence = index.blocks.size();
+    const int time = TimeIndexParse(blockChain.timestamp.text());
+    index.blocks.push_back(&blockChain);
+    index.times.push_back(time);
+    if (time == TimeIndex::INVALID_TIME) {
+        return;
+    }
+    if (!index.entries.empty() && time < index.entries.back().time) {
+        index.isStale = true;
+        return;
+    }
+    addEntry(index, {time, sequence});
+}
+
+//****************************************************************************//
+
+//Returns the running balance of the account over every change before a time
+unsigned int balanceBefore(const std::vector<TimeIndexBalance>& balances, const int time)
+{
+    const auto after = std::lower_bound(balances.begin(), balances.end(), time,
+        [](const TimeIndexBalance& balance, const int value) { return balance.time < value; });
+    return after == balances.begin() ? 0 : (after - 1)->balance;
+}
+
+//****************************************************************************//
+
+int TimeIndexWindowBalance(const TimeIndex& index, const AccountName account,
+    const int from, const int to)
+{
+    if (account.id >= index.balances.size() || from >= to) {
+        return 0;
+    }
+    const std::vector<TimeIndexBalance>& balances = index.balances[account.id];
+    return static_cast<int>(balanceBefore(balances, to) - balanceBefore(balances, from));
+}
+
+//****************************************************************************//
+
+std::vector<int> TimeIndexWindow(const TimeIndex& index, const int from, const int to)
+{
+    std::vector<int> ranks;
+    if (from >= to) {
+        return ranks;
+    }
+    const auto first = std::lower_bound(index.entries.begin(), index.entries.end(),
+        TimeIndexEntry{from, -1});
+    const auto last = std::lower_bound(first, index.entries.end(), TimeIndexEntry{to, -1});
+    const int size = index.blocks.size();
+    for (auto entry = first; entry != last; ++entry) {
+        ranks.push_back(size - entry->sequence);
+    }
+    std::sort(ranks.begin(), ranks.end());
+    return ranks;
+}
+
+//****************************************************************************//
+
+const BlockChain* TimeIndexBlockOfRank(const TimeIndex& index, const int rank)
+{
+    return index.blocks[index.blocks.size() - rank];
+}
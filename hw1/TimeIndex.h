@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "Transaction.h"
+
+struct BlockChain;
+
+
+/**
+*
+ * TimeIndex - Parsed timestamps of a BlockChain, sorted for windowed queries
+ *
+ * Timestamps are parsed into seconds since midnight ("HH:MM" or "HH:MM:SS").
+ * Blocks are numbered by their sequence, from 0 at the tail, which does not
+ * change when a transaction is appended at the head. For each account the
+ * index keeps its balance changes sorted by time together with their running
+ * sum, so the balance over a window takes two binary searches. Sums wrap
+ * around like the int balances of BlockChainPersonalBalance.
+ *
+ * Blocks whose timestamp cannot be parsed belong to no window.
+ *
+*/
+struct TimeIndexEntry {
+
+      int time;
+      int sequence;
+};
+
+struct TimeIndexBalance {
+
+      int time;
+      unsigned int balance;
+};
+
+struct TimeIndex {
+
+      static const int INVALID_TIME = -1;
+
+      //The Block of every sequence, and its parsed timestamp
+      std::vector<const BlockChain*> blocks;
+      std::vector<int> times;
+      //Every Block with a valid timestamp, sorted by time, then by sequence
+      std::vector<TimeIndexEntry> entries;
+      //Running balances by AccountName id, sorted by time
+      std::vector<std::vector<TimeIndexBalance>> balances;
+      //Set when the chain changed in a way the index could not follow
+      bool isStale = false;
+};
+
+
+/**
+ * TimeIndexParse - parses a timestamp into seconds since midnight
+ *
+ * @param timestamp "HH:MM" or "HH:MM:SS"
+ *
+ * @return The number of seconds, TimeIndex::INVALID_TIME if the timestamp is malformed
+*/
+int TimeIndexParse(std::string_view timestamp);
+
+
+/**
+ * TimeIndexBuild - rebuilds the index from every Block of a chain
+ *
+ * @param index Index to rebuild
+ * @param blockChain Head of the chain
+*/
+void TimeIndexBuild(TimeIndex& index, const BlockChain& blockChain);
+
+
+/**
+ * TimeIndexAppend - follows a transaction just appended at the head of the chain
+ *
+ * A transaction no earlier than every indexed one is added in constant
+ * time; any other marks the index as stale.
+ *
+ * @param index Index built over the chain
+ * @param blockChain Head of the chain, holding the new transaction
+*/
+void TimeIndexAppend(TimeIndex& index, const BlockChain& blockChain);
+
+
+/**
+ * TimeIndexWindowBalance - returns the balance of an account over a window of time
+ *
+ * @param index Index to query
+ * @param account Account to sum
+ * @param from Start of the window, in seconds, included
+ * @param to End of the window, in seconds, excluded
+*/
+int TimeIndexWindowBalance(const TimeIndex& index, AccountName account, int from, int to);
+
+
+/**
+ * TimeIndexWindow - returns the ranks of the Blocks in a window of time
+ *
+ * @param index Index to query
+ * @param from Start of the window, in seconds, included
+ * @param to End of the window, in seconds, excluded
+ *
+ * @return The ranks, from 1 at the head as in BlockChainDump, in increasing order
+*/
+std::vector<int> TimeIndexWindow(const TimeIndex& index, int from, int to);
+
+
+/**
+ * TimeIndexBlockOfRank - returns the Block at a given rank of the indexed chain
+*/
+const BlockChain* TimeIndexBlockOfRank(const TimeIndex& index, int rank);
@@ -3,6 +3,97 @@
 
 //****************************************************************************//
 
+InternTable& AccountNames()
+{
+    static InternTable table;
+    return table;
+}
+
+//****************************************************************************//
+
+AccountName::AccountName(const string& name) :
+    id(InternTableIntern(AccountNames(), name)) {}
+
+AccountName::AccountName(const char* name) :
+    id(InternTableIntern(AccountNames(), name)) {}
+
+AccountName::AccountName(const std::string_view name) :
+    id(InternTableIntern(AccountNames(), name)) {}
+
+const string& AccountName::name() const
+{
+    return InternTableName(AccountNames(), id);
+}
+
+//****************************************************************************//
+
+bool operator==(const AccountName lhs, const AccountName rhs)
+{
+    return lhs.id == rhs.id;
+}
+
+bool operator!=(const AccountName lhs, const AccountName rhs)
+{
+    return lhs.id != rhs.id;
+}
+
+std::ostream& operator<<(std::ostream& os, const AccountName accountName)
+{
+    return os << accountName.name();
+}
+
+std::istream& operator>>(std::istream& is, AccountName& accountName)
+{
+    string name;
+    if (is >> name) {
+        accountName = AccountName(name);
+    }
+    return is;
+}
+
+//****************************************************************************//
+
+InternTable& Timestamps()
+{
+    static InternTable table;
+    return table;
+}
+
+//****************************************************************************//
+
+Timestamp::Timestamp(const string& timestamp) :
+    id(InternTableIntern(Timestamps(), timestamp)) {}
+
+Timestamp::Timestamp(const char* timestamp) :
+    id(InternTableIntern(Timestamps(), timestamp)) {}
+
+Timestamp::Timestamp(const std::string_view timestamp) :
+    id(InternTableIntern(Timestamps(), timestamp)) {}
+
+const string& Timestamp::text() const
+{
+    return InternTableName(Timestamps(), id);
+}
+
+//****************************************************************************//
+
+bool operator==(const Timestamp lhs, const Timestamp rhs)
+{
+    return lhs.id == rhs.id;
+}
+
+bool operator!=(const Timestamp lhs, const Timestamp rhs)
+{
+    return lhs.id != rhs.id;
+}
+
+std::ostream& operator<<(std::ostream& os, const Timestamp timestamp)
+{
+    return os << timestamp.text();
+}
+
+//****************************************************************************//
+
 void TransactionDumpInfo(const Transaction& transaction, ofstream& file) {
         file << "Sender Name: " << transaction.sender << std::endl;
         file << "Receiver Name: " << transaction.receiver << std::endl;
@@ -11,8 +102,21 @@ void TransactionDumpInfo(const Transaction& transaction, ofstream& file) {
 
 //****************************************************************************//
 
+void TransactionDumpInfo(const Transaction& transaction, OutputBuffer& buffer) {
+        OutputBufferWrite(buffer, "Sender Name: ");
+        OutputBufferWrite(buffer, transaction.sender.name());
+        OutputBufferWrite(buffer, "\nReceiver Name: ");
+        OutputBufferWrite(buffer, transaction.receiver.name());
+        OutputBufferWrite(buffer, "\nTransaction Value: ");
+        OutputBufferWriteNumber(buffer, transaction.value);
+        OutputBufferWrite(buffer, "\n");
+}
+
+//****************************************************************************//
+
 string TransactionHashedMessage(const Transaction& transaction) {
-    return hash(transaction.value, transaction.sender, transaction.receiver);
+    return hash(transaction.value, transaction.sender.name(),
+        transaction.receiver.name());
 }
 
 //****************************************************************************//
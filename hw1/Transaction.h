@@ -3,11 +3,83 @@
 
 #include <string>
 #include <fstream>
+#include <iostream>
+
+#include "InternTable.h"
+#include "OutputBuffer.h"
 
 using std::string;
 using std::ofstream;
 
 
+/**
+*
+ * AccountName - An account name interned in the AccountNames table
+ *
+ * Holds only the id of the name, so copying and comparing two AccountNames
+ * are integer operations. A default AccountName is the empty name.
+ *
+*/
+struct AccountName {
+    unsigned int id = 0;
+
+    AccountName() = default;
+    AccountName(const string& name);
+    AccountName(const char* name);
+    AccountName(std::string_view name);
+
+    /**
+     * name - returns the interned string, valid for the lifetime of the program
+    */
+    const string& name() const;
+};
+
+bool operator==(AccountName lhs, AccountName rhs);
+bool operator!=(AccountName lhs, AccountName rhs);
+std::ostream& operator<<(std::ostream& os, AccountName accountName);
+std::istream& operator>>(std::istream& is, AccountName& accountName);
+
+
+/**
+ * AccountNames - returns the table every AccountName is interned in
+*/
+InternTable& AccountNames();
+
+
+/**
+*
+ * Timestamp - A timestamp interned in the Timestamps table
+ *
+ * Ledgers reuse a few thousand distinct timestamps over millions of Blocks,
+ * so each one is stored once and a Block holds only its id. A default
+ * Timestamp is the empty one, which no transaction ever has.
+ *
+*/
+struct Timestamp {
+    unsigned int id = 0;
+
+    Timestamp() = default;
+    Timestamp(const string& timestamp);
+    Timestamp(const char* timestamp);
+    Timestamp(std::string_view timestamp);
+
+    /**
+     * text - returns the interned string, valid for the lifetime of the program
+    */
+    const string& text() const;
+};
+
+bool operator==(Timestamp lhs, Timestamp rhs);
+bool operator!=(Timestamp lhs, Timestamp rhs);
+std::ostream& operator<<(std::ostream& os, Timestamp timestamp);
+
+
+/**
+ * Timestamps - returns the table every Timestamp is interned in
+*/
+InternTable& Timestamps();
+
+
 /**
 *
  * Transaction - Defining the new Transaction Type
@@ -15,8 +87,8 @@ using std::ofstream;
 */
 struct Transaction {
     unsigned int value;
-    string sender;
-    string receiver;
+    AccountName sender;
+    AccountName receiver;
 };
 
 
@@ -33,6 +105,17 @@ struct Transaction {
 void TransactionDumpInfo(const Transaction& transaction, ofstream& file);
 
 
+/**
+ * TransactionDumpInfo - Appends the data of the transaction to a given OutputBuffer
+ *
+ * Same format as above, without flushing after every line
+ *
+ * @param transaction Transaction to print
+ * @param buffer Buffer to append to
+*/
+void TransactionDumpInfo(const Transaction& transaction, OutputBuffer& buffer);
+
+
 /**
  * TransactionHashMessage - Hashs the message of the transaction
  *
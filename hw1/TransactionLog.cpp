@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+
+#include "TransactionLog.h"
+#include "BlockChain.h"
+#include "MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define TRANSACTION_LOG_FSYNC
+#endif
+
+//****************************************************************************//
+
+//  The file starts with the magic and the version, then holds one record per
+//  append: a LogRecordHeader followed by the sender, the receiver and the
+//  timestamp, back to back. The checksum covers everything after itself.
+
+static const char LOG_MAGIC[4] = {'H', 'W', '1', 'W'};
+static const uint32_t LOG_VERSION = 1;
+static const size_t LOG_PREAMBLE_SIZE = sizeof(LOG_MAGIC) + sizeof(LOG_VERSION);
+
+struct LogRecordHeader {
+    uint32_t checksum;
+    uint32_t senderSize;
+    uint32_t receiverSize;
+    uint32_t value;
+    uint32_t timestampSize;
+};
+
+static_assert(sizeof(LogRecordHeader) == 20, "LogRecordHeader must have no padding");
+
+//****************************************************************************//
+
+//32-bit FNV-1a
+uint32_t logChecksum(const char* data, const size_t size)
+{
+    uint32_t checksum = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        checksum ^= static_cast<unsigned char>(data[i]);
+        checksum *= 16777619u;
+    }
+    return checksum;
+}
+
+//****************************************************************************//
+
+//Reads the header of the record at position, returning false if the record is torn
+bool readRecord(const char* position, const char* end, LogRecordHeader& header)
+{
+    if (static_cast<size_t>(end - position) < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, position, sizeof(header));
+    const uint64_t payloadSize = uint64_t(header.senderSize) + header.receiverSize +
+        header.timestampSize;
+    if (payloadSize > static_cast<size_t>(end - position) - sizeof(header)) {
+        return false;
+    }
+    const size_t checkedSize = sizeof(header) - sizeof(header.checksum) + payloadSize;
+    return logChecksum(position + sizeof(header.checksum), checkedSize) == header.checksum;
+}
+
+//****************************************************************************//
+
+//Cuts a torn record off the end of a log, so that new records follow the last whole one
+bool dropTornTail(const string& path)
+{
+    size_t validSize;
+    size_t fileSize;
+    {
+        MappedFile file;
+        if (!MappedFileOpen(file, path)) {
+            return false;
+        }
+        const char* position = file.data + LOG_PREAMBLE_SIZE;
+        const char* const end = file.data + file.size;
+        LogRecordHeader header;
+        while (readRecord(position, end, header)) {
+            position += sizeof(header) + header.senderSize + header.receiverSize +
+                header.timestampSize;
+        }
+        validSize = position - file.data;
+        fileSize = file.size;
+    }
+    std::error_code error;
+    if (validSize < fileSize) {
+        std::filesystem::resize_file(path, validSize, error);
+    }
+    return !error;
+}
+
+//****************************************************************************//
+
+TransactionLog::TransactionLog() : file(nullptr), pendingCount(0), batchSize(1)
+{
+}
+
+//****************************************************************************//
+
+TransactionLog::~TransactionLog()
+{
+    TransactionLogClose(*this);
+}
+
+//****************************************************************************//
+
+bool TransactionLogOpen(TransactionLog& log, const string& path, const int batchSize)
+{
+    TransactionLogClose(log);
+    log.batchSize = batchSize < 1 ? 1 : batchSize;
+    const bool exists = TransactionLogIsLog(path);
+    if (exists && !dropTornTail(path)) {
+        return false;
+    }
+    log.file = std::fopen(path.c_str(), "ab");
+    if (log.file == nullptr) {
+        return false;
+    }
+    log.path = path;
+    //Batches are collected in pending already, and a failed one is cut off the file
+    //again, which a stdio buffer still holding part of it would undo
+    std::setvbuf(log.file, nullptr, _IONBF, 0);
+    if (!exists) {
+        //Only an empty file may become a log, anything else is left alone
+        if (std::fseek(log.file, 0, SEEK_END) != 0 || std::ftell(log.file) != 0) {
+            std::fclose(log.file);
+            log.file = nullptr;
+            return false;
+        }
+        log.pending.insert(log.pending.end(), LOG_MAGIC, LOG_MAGIC + sizeof(LOG_MAGIC));
+        const char* version = reinterpret_cast<const char*>(&LOG_VERSION);
+        log.pending.insert(log.pending.end(), version, version + sizeof(LOG_VERSION));
+        return TransactionLogCommit(log);
+    }
+    return true;
+}
+
+//****************************************************************************//
+
+bool TransactionLogAppend(TransactionLog& log, const Transaction& transaction,
+    const string& timestamp)
+{
+    const string& sender = transaction.sender.name();
+    const string& receiver = transaction.receiver.name();
+    LogRecordHeader header = {0, static_cast<uint32_t>(sender.size()),
+        static_cast<uint32_t>(receiver.size()), transaction.value,
+        static_cast<uint32_t>(timestamp.size())};
+    const size_t start = log.pending.size();
+    log.pending.resize(start + sizeof(header));
+    log.pending.insert(log.pending.end(), sender.begin(), sender.end());
+    log.pending.insert(log.pending.end(), receiver.begin(), receiver.end());
+    log.pending.insert(log.pending.end(), timestamp.begin(), timestamp.end());
+    std::memcpy(log.pending.data() + start, &header, sizeof(header));
+    header.checksum = logChecksum(log.pending.data() + start + sizeof(header.checksum),
+        log.pending.size() - start - sizeof(header.checksum));
+    std::memcpy(log.pending.data() + start, &header.checksum, sizeof(header.checksum));
+    if (++log.pendingCount < log.batchSize) {
+        return true;
+    }
+    return TransactionLogCommit(log);
+}
+
+//****************************************************************************//
+
+bool TransactionLogCommit(TransactionLog& log)
+{
+    if (log.file == nullptr) {
+        return false;
+    }
+    if (log.pending.empty()) {
+        return true;
+    }
+    const long start = std::fseek(log.file, 0, SEEK_END) == 0 ? std::ftell(log.file) : -1;
+    if (start < 0) {
+        return false;
+    }
+    bool isWritten = std::fwrite(log.pending.data(), 1, log.pending.size(), log.file) ==
+        log.pending.size() && std::fflush(log.file) == 0;
+#ifdef TRANSACTION_LOG_FSYNC
+    isWritten = isWritten && fsync(fileno(log.file)) == 0;
+#endif
+    if (!isWritten) {
+        //The batch stays pending for the next commit, whatever part of it was written goes
+        std::clearerr(log.file);
+        std::error_code error;
+        std::filesystem::resize_file(log.path, start, error);
+        return false;
+    }
+    log.pending.clear();
+    log.pendingCount = 0;
+    return true;
+}
+
+//****************************************************************************//
+
+bool TransactionLogClose(TransactionLog& log)
+{
+    if (log.file == nullptr) {
+        return true;
+    }
+    const bool isCommitted = TransactionLogCommit(log);
+    std::fclose(log.file);
+    log.file = nullptr;
+    return isCommitted;
+}
+
+//****************************************************************************//
+
+bool TransactionLogIsLog(const string& path)
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    char preamble[LOG_PREAMBLE_SIZE];
+    const bool isLog = std::fread(preamble, 1, sizeof(preamble), file) == sizeof(preamble) &&
+        std::memcmp(preamble, LOG_MAGIC, sizeof(LOG_MAGIC)) == 0 &&
+        std::memcmp(preamble + sizeof(LOG_MAGIC), &LOG_VERSION, sizeof(LOG_VERSION)) == 0;
+    std::fclose(file);
+    return isLog;
+}
+
+//****************************************************************************//
+
+long long TransactionLogReplay(const string& path, BlockChain& blockChain)
+{
+    return TransactionLogReplayFrom(path, 0, blockChain);
+}
+
+//****************************************************************************//
+
+long long TransactionLogReplayFrom(const string& path, const long long first,
+    BlockChain& blockChain)
+{
+    MappedFile file;
+    if (!TransactionLogIsLog(path) || !MappedFileOpen(file, path)) {
+        return -1;
+    }
+    long long count = 0;
+    const char* position = file.data + LOG_PREAMBLE_SIZE;
+    const char* const end = file.data + file.size;
+    Transaction transaction;
+    string timestamp;
+    LogRecordHeader header;
+    while (readRecord(position, end, header)) {
+        const char* payload = position + sizeof(header);
+        transaction.sender = AccountName(std::string_view(payload, header.senderSize));
+        payload += header.senderSize;
+        transaction.receiver = AccountName(std::string_view(payload, header.receiverSize));
+        payload += header.receiverSize;
+        transaction.value = header.value;
+        timestamp.assign(payload, header.timestampSize);
+        if (count >= first) {
+            BlockChainAppendTransaction(blockChain, transaction, timestamp);
+        }
+        position = payload + header.timestampSize;
+        count++;
+    }
+    return std::max(count - first, 0LL);
+}
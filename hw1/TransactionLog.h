@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Transaction.h"
+
+using std::string;
+
+struct BlockChain;
+
+
+/**
+*
+ * TransactionLog - An append-only log of the transactions added to a chain
+ *
+ * Appends are collected in memory and written out together, followed by a
+ * single fsync, once batchSize of them are pending (group commit): a larger
+ * batch means fewer syncs and more throughput, but up to batchSize - 1
+ * appends may be lost in a crash. TransactionLogCommit forces a commit.
+ *
+ * Each record carries a checksum, so a record torn by a crash in the middle
+ * of a write is recognized: replay stops there, and reopening the log cuts it
+ * off before anything new is appended. A commit that fails is cut off the
+ * same way and stays pending, to be written again by the next commit.
+ *
+*/
+struct TransactionLog {
+
+      std::FILE* file;
+      string path;
+      std::vector<char> pending;
+      int pendingCount;
+      int batchSize;
+
+      TransactionLog();
+      TransactionLog(const TransactionLog&) = delete;
+      TransactionLog& operator=(const TransactionLog&) = delete;
+      ~TransactionLog();
+};
+
+
+/**
+ * TransactionLogOpen - opens a log for appending, creating it if needed
+ *
+ * @param log Log to open, a previously open file is closed first
+ * @param path Path of the log file
+ * @param batchSize Number of appends committed together, at least 1
+ *
+ * @return true if the file could be opened and is a log, false otherwise
+*/
+bool TransactionLogOpen(TransactionLog& log, const string& path, int batchSize);
+
+
+/**
+ * TransactionLogAppend - adds a transaction to the log, committing when the batch is full
+ *
+ * @param log Log to append to
+ * @param transaction Transaction that was appended to the chain
+ * @param timestamp Timestamp it was appended with
+ *
+ * @return false if a commit was due and failed, true otherwise
+*/
+bool TransactionLogAppend(TransactionLog& log, const Transaction& transaction,
+    const string& timestamp);
+
+
+/**
+ * TransactionLogCommit - writes out every pending append and syncs the file
+ *
+ * @param log Log to commit
+ *
+ * @return true if everything reached the disk, false otherwise, in which case
+ * the appends are kept pending
+*/
+bool TransactionLogCommit(TransactionLog& log);
+
+
+/**
+ * TransactionLogClose - commits the pending appends and closes the file
+ *
+ * @param log Log to close
+ *
+ * @return true if the final commit succeeded, false otherwise
+*/
+bool TransactionLogClose(TransactionLog& log);
+
+
+/**
+ * TransactionLogIsLog - tells whether a file holds a transaction log
+ *
+ * @param path Path of the file to check
+ *
+ * @return true if the file starts like a log, false otherwise
+*/
+bool TransactionLogIsLog(const string& path);
+
+
+/**
+ * TransactionLogReplay - appends every committed transaction of a log to a chain
+ *
+ * The transactions are appended with BlockChainAppendTransaction in the
+ * order they were logged, so replaying into an empty chain rebuilds the
+ * chain that was logged, head-insertion order included. A torn record at
+ * the end of the log, and anything after it, is ignored.
+ *
+ * @param path Path of the log file
+ * @param blockChain Chain to append to
+ *
+ * @return The number of transactions replayed, -1 if the file is not a log
+*/
+long long TransactionLogReplay(const string& path, BlockChain& blockChain);
+
+
+/**
+ * TransactionLogReplayFrom - appends the committed transactions of a log that
+ * follow a given number of records, as TransactionLogReplay does
+ *
+ * Used to catch up a chain restored from a checkpoint that already holds
+ * the first records of the log.
+ *
+ * @param path Path of the log file
+ * @param first Number of records to skip
+ * @param blockChain Chain to append to
+ *
+ * @return The number of transactions replayed, -1 if the file is not a log
+*/
+long long TransactionLogReplayFrom(const string& path, long long first,
+    BlockChain& blockChain);
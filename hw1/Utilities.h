@@ -9,6 +9,9 @@ using std::string;
 /**
  * hash - Hashes a given string according to a given key
  *
+ * Runs the fastest kernel in HashKernels.h that the CPU supports, all of
+ * them producing the same digest.
+ *
  * @param key Hashing key
  * @param value1 First hashing value
  * @param value2 Second hashing value
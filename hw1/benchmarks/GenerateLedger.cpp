@@ -0,0 +1,27 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "LedgerGenerator.h"
+
+//Usage: GenerateLedger <rows> <accounts> <max run> <seed> <target>
+
+int main(int argc, char** argv)
+{
+    if (argc != 6) {
+        std::cout << "Usage: " << argv[0] << " <rows> <accounts> <max run> <seed> <target>"
+            << std::endl;
+        return 1;
+    }
+    LedgerGeneratorOptions options;
+    options.rows = std::stoll(argv[1]);
+    options.accounts = std::stoi(argv[2]);
+    options.maxRun = std::stoi(argv[3]);
+    options.seed = std::stoull(argv[4]);
+    std::ofstream target(argv[5]);
+    if (!target.is_open()) {
+        return 1;
+    }
+    LedgerGenerate(options, target);
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "LedgerGenerator.h"
+#include "../BlockChain.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define LEDGER_BENCHMARK_RUSAGE
+#endif
+
+//  Times every hw1 operation on generated ledgers of growing size and prints
+//  the results as JSON on stdout:
+//
+//    LedgerBenchmark [--rows N]... [--threads N] [--accounts K] [--max-run R]
+//
+//  Without --rows the sizes are 10^4, 10^5 and 10^6; any size up to 10^8 and
+//  beyond can be asked for, given the memory and disk space. Peak RSS is the
+//  peak of the whole process so far, so sizes are run in the order given.
+
+static const char* SOURCE_PATH = "LedgerBenchmark.source";
+static const char* OUTPUT_PATH = "LedgerBenchmark.output";
+static const char* HASHED_PATH = "LedgerBenchmark.hashed";
+
+struct BenchmarkOptions {
+    std::vector<long long> rows;
+    int threads = 1;
+    LedgerGeneratorOptions generator;
+};
+
+//****************************************************************************//
+
+bool parseOptions(int argc, char** argv, BenchmarkOptions& options)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (i + 1 == argc) {
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (argument == "--rows") {
+            options.rows.push_back(std::stoll(value));
+        }
+        else if (argument == "--threads") {
+            options.threads = std::stoi(value);
+        }
+        else if (argument == "--accounts") {
+            options.generator.accounts = std::stoi(value);
+        }
+        else if (argument == "--max-run") {
+            options.generator.maxRun = std::stoi(value);
+        }
+        else {
+            return false;
+        }
+    }
+    if (options.rows.empty()) {
+        options.rows = {10000, 100000, 1000000};
+    }
+    return options.threads >= 1;
+}
+
+//****************************************************************************//
+
+long peakRssKilobytes()
+{
+#ifdef LEDGER_BENCHMARK_RUSAGE
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
+//****************************************************************************//
+
+//Runs the operation once and prints its JSON record
+void measure(const char* operation, const long long rows, const std::function<void()>& run,
+    bool& isFirst)
+{
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const double seconds = elapsed.count();
+    std::cout << (isFirst ? "\n" : ",\n") << "    {\"rows\": " << rows
+        << ", \"operation\": \"" << operation << "\", \"seconds\": " << seconds
+        << ", \"rows_per_second\": " << (seconds > 0 ? rows / seconds : 0)
+        << ", \"peak_rss_kb\": " << peakRssKilobytes() << "}";
+    isFirst = false;
+}
+
+//****************************************************************************//
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--rows N]... [--threads N]"
+            << " [--accounts K] [--max-run R]" << std::endl;
+        return 1;
+    }
+    std::cout << "{\n  \"threads\": " << options.threads
+        << ",\n  \"accounts\": " << options.generator.accounts
+        << ",\n  \"max_run\": " << options.generator.maxRun
+        << ",\n  \"results\": [";
+    bool isFirst = true;
+    for (const long long rows : options.rows) {
+        options.generator.rows = rows;
+        {
+            std::ofstream source(SOURCE_PATH);
+            LedgerGenerate(options.generator, source);
+        }
+        Ledger ledger;
+        BlockChain* blockChain = nullptr;
+        measure("load", rows, [&]() {
+            blockChain = BlockChainLoadParallel(SOURCE_PATH, ledger, options.threads);
+        }, isFirst);
+        measure("format", rows, [&]() {
+            std::ofstream target(OUTPUT_PATH);
+            BlockChainDump(*blockChain, target);
+        }, isFirst);
+        measure("hash", rows, [&]() {
+            std::ofstream target(HASHED_PATH);
+            BlockChainDumpHashedParallel(*blockChain, target, options.threads);
+        }, isFirst);
+        measure("verify", rows, [&]() {
+            std::ifstream target(HASHED_PATH);
+            if (!BlockChainVerifyFileParallel(*blockChain, target, options.threads)) {
+                std::cerr << "Verification failed at " << rows << " rows" << std::endl;
+            }
+        }, isFirst);
+        measure("compress", rows, [&]() {
+            BlockChainCompressParallel(*blockChain, options.threads);
+        }, isFirst);
+        measure("balance", rows, [&]() {
+            BlockChainAllBalances(*blockChain);
+        }, isFirst);
+    }
+    std::cout << "\n  ]\n}" << std::endl;
+    std::remove(SOURCE_PATH);
+    std::remove(OUTPUT_PATH);
+    std::remove(HASHED_PATH);
+    return 0;
+}
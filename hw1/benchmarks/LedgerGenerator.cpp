@@ -0,0 +1,41 @@
+#include <random>
+#include <string_view>
+#include <string>
+
+#include "LedgerGenerator.h"
+#include "../OutputBuffer.h"
+
+//****************************************************************************//
+
+void LedgerGenerate(const LedgerGeneratorOptions& options, std::ostream& file)
+{
+    static const int MINUTES_PER_DAY = 24 * 60;
+    static const unsigned int MAX_VALUE = 1000;
+    //The engine is fully specified by the standard, unlike the distributions,
+    //so only its raw output is used
+    std::mt19937_64 random(options.seed);
+    const int accounts = options.accounts < 1 ? 1 : options.accounts;
+    const int maxRun = options.maxRun < 1 ? 1 : options.maxRun;
+    OutputBuffer buffer(file);
+    long long row = 0;
+    while (row < options.rows) {
+        const std::string sender = "acct" + std::to_string(random() % accounts);
+        const std::string receiver = "acct" + std::to_string(random() % accounts);
+        const long long run = 1 + random() % maxRun;
+        for (long long i = 0; i < run && row < options.rows; i++, row++) {
+            const int minute = row * MINUTES_PER_DAY / options.rows;
+            const char timestamp[] = {
+                static_cast<char>('0' + minute / 600), static_cast<char>('0' + minute / 60 % 10),
+                ':', static_cast<char>('0' + minute % 60 / 10), static_cast<char>('0' + minute % 10)
+            };
+            OutputBufferWrite(buffer, sender);
+            OutputBufferWrite(buffer, " ");
+            OutputBufferWrite(buffer, receiver);
+            OutputBufferWrite(buffer, " ");
+            OutputBufferWriteNumber(buffer, 1 + random() % MAX_VALUE);
+            OutputBufferWrite(buffer, " ");
+            OutputBufferWrite(buffer, std::string_view(timestamp, sizeof(timestamp)));
+            OutputBufferWrite(buffer, "\n");
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ostream>
+
+
+/**
+*
+ * LedgerGeneratorOptions - Shape of a synthetic ledger
+ *
+ * Rows come in runs of 1 to maxRun consecutive transactions between the
+ * same sender and receiver, which is what BlockChainCompress merges.
+ * The same options and seed always produce the same file, on any platform.
+ *
+*/
+struct LedgerGeneratorOptions {
+
+      long long rows = 10000;
+      int accounts = 1000;
+      int maxRun = 4;
+      unsigned long long seed = 234124;
+};
+
+
+/**
+ * LedgerGenerate - writes a ledger in the text format read by BlockChainLoad
+ *
+ * @param options Shape of the ledger
+ * @param file Stream to write to
+*/
+void LedgerGenerate(const LedgerGeneratorOptions& options, std::ostream& file);
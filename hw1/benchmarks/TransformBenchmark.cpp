@@ -0,0 +1,50 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../BlockChain.h"
+
+//Times BlockChainTransform through a function pointer against the same
+//update passed as a lambda, over a chain of BLOCKS Blocks
+
+static const int BLOCKS = 2000000;
+static const int ROUNDS = 20;
+
+template <typename Transform>
+double millisecondsPerRound(BlockChain& blockChain, Transform transform)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        transform(blockChain);
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ROUNDS;
+}
+
+int main(int argc, char** argv)
+{
+    const int blocks = argc > 1 ? std::stoi(argv[1]) : BLOCKS;
+    Ledger ledger;
+    BlockChain& blockChain = LedgerHead(ledger);
+    for (int i = 0; i < blocks; i++) {
+        BlockChainAppendTransaction(blockChain, i, "sender" + std::to_string(i % 100),
+            "receiver" + std::to_string(i % 37), "2024-01-01T00:00:00");
+    }
+
+    const double pointer = millisecondsPerRound(blockChain, [](BlockChain& chain) {
+        BlockChainTransform(chain, TimesTwo);
+    });
+    const double lambda = millisecondsPerRound(blockChain, [](BlockChain& chain) {
+        BlockChainTransform(chain, [](const unsigned int value) { return value * 2; });
+    });
+    const double range = millisecondsPerRound(blockChain, [blocks](BlockChain& chain) {
+        BlockChainTransformRange(chain, 1, blocks / 10,
+            [](const unsigned int value) { return value * 2; });
+    });
+    std::cout << "blocks: " << blocks << std::endl;
+    std::cout << "function pointer: " << pointer << " ms" << std::endl;
+    std::cout << "lambda: " << lambda << " ms" << std::endl;
+    std::cout << "range of 10%: " << range << " ms" << std::endl;
+    return 0;
+}
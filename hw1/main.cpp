@@ -1,5 +1,18 @@
+#include <algorithm>
 #include <iostream>
+#include <cstdlib>
+#include <filesystem>
+#include <future>
+#include <sstream>
+#include <vector>
+#include "AccountGraph.h"
 #include "BlockChain.h"
+#include "Checkpoint.h"
+#include "MerkleTree.h"
+#include "Stats.h"
+#include "ThreadPool.h"
+#include "TimeIndex.h"
+#include "TransactionLog.h"
 #include "Utilities.h"
 
 enum arguments {
@@ -10,61 +23,502 @@ enum arguments {
     ARGS_COUNT
 };
 
-int main(int argc, char** argv)
+//Writes the number of Blocks and the root digest of the chain
+void writeMerkleRoot(const MerkleTree& tree, ofstream& target)
 {
-    if (argc == ARGS_COUNT) {
-        const string command = argv[COMMAND];
-        ifstream source(argv[FILE_1]);
-        if (source.is_open())
+    target << MerkleTreeSize(tree) << " " << sha256Hex(MerkleTreeRoot(tree)) << std::endl;
+}
+
+//Writes the root, the Block's hashed message and the siblings up to the root, one per line
+bool writeMerkleProof(const MerkleTree& tree, const BlockChain& blockChain,
+    const int rank, ofstream& target)
+{
+    const BlockChain* block = &blockChain;
+    for (int i = 1; i < rank && block != nullptr; i++) {
+        block = block->next;
+    }
+    if (block == nullptr || rank > MerkleTreeSize(tree)) {
+        return false;
+    }
+    writeMerkleRoot(tree, target);
+    target << rank << " " << TransactionHashedMessage(block->transaction) << std::endl;
+    for (const MerkleProofStep& step :
+        MerkleTreeProve(tree, MerkleTreeLeafOfRank(tree, rank))) {
+        target << (step.siblingOnLeft ? "L " : "R ") << sha256Hex(step.sibling) << std::endl;
+    }
+    return true;
+}
+
+//Writes the accounts an account exchanged the most value with, one "name sent received" per line
+void writeCounterparties(const AccountGraph& graph, const AccountName account,
+    const int count, ofstream& target)
+{
+    for (const Counterparty& counterparty :
+        AccountGraphTopCounterparties(graph, account, count)) {
+        target << counterparty.account << " " << counterparty.sent << " "
+            << counterparty.received << std::endl;
+    }
+}
+
+//Writes what each of two accounts sent the other and what the first one gained overall
+void writeNetFlow(const AccountGraph& graph, const AccountName account,
+    const AccountName other, ofstream& target)
+{
+    target << account << " " << other << " " << AccountGraphSent(graph, account, other)
+        << " " << AccountGraphSent(graph, other, account) << " "
+        << AccountGraphNetFlow(graph, account, other) << std::endl;
+}
+
+//Finds an account that some transaction named, reporting the name to err otherwise
+bool findAccount(const string& name, AccountName& account, std::ostream& err)
+{
+    if (!InternTableFind(AccountNames(), name, account.id)) {
+        err << "Unknown account: " << name << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//Writes the accounts of one circular transfer in transfer order, nothing if there is none
+void writeCycle(const AccountGraph& graph, ofstream& target)
+{
+    for (const AccountName account : AccountGraphFindCycle(graph)) {
+        target << account << std::endl;
+    }
+}
+
+//Options may appear anywhere on the command line, everything else is positional
+struct Options {
+    int threads = 1;
+    int block = 1;
+    //Prints counters and timings of every phase on stderr when the program ends
+    bool stats = false;
+    //Compresses a text source in one pass instead of loading it first
+    bool stream = false;
+    //Window of time for format and hash, both empty unless given
+    string from;
+    string to;
+    //Accounts and the number of results for the account graph queries
+    string account;
+    string other;
+    int count = 10;
+    std::vector<char*> arguments;
+};
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 0; i < argc; i++) {
+        const string argument = argv[i];
+        if (argument == "--threads") {
+            if (i + 1 == argc) {
+                return false;
+            }
+            options.threads = std::atoi(argv[++i]);
+            if (options.threads < 1) {
+                return false;
+            }
+        }
+        else if (argument == "--from" || argument == "--to") {
+            if (i + 1 == argc) {
+                return false;
+            }
+            (argument == "--from" ? options.from : options.to) = argv[++i];
+        }
+        else if (argument == "--account" || argument == "--other") {
+            if (i + 1 == argc) {
+                return false;
+            }
+            (argument == "--account" ? options.account : options.other) = argv[++i];
+        }
+        else if (argument == "--count") {
+            if (i + 1 == argc) {
+                return false;
+            }
+            options.count = std::atoi(argv[++i]);
+            if (options.count < 1) {
+                return false;
+            }
+        }
+        else if (argument == "--stats") {
+            options.stats = true;
+        }
+        else if (argument == "--stream") {
+            options.stream = true;
+        }
+        else if (argument == "--block") {
+            if (i + 1 == argc) {
+                return false;
+            }
+            options.block = std::atoi(argv[++i]);
+            if (options.block < 1) {
+                return false;
+            }
+        }
+        else {
+            options.arguments.push_back(argv[i]);
+        }
+    }
+    return true;
+}
+
+//Runs one command against the loaded chain. Messages for the user go to out and
+//diagnostics to err, and the exit status is returned
+int runCommand(const string& command, const char* path, BlockChain& blockChain,
+    const MerkleTree& merkle, const Options& options, const int block,
+    std::ostream& out, std::ostream& err)
+{
+    const bool isWindowed = !options.from.empty() || !options.to.empty();
+    //Every command but merkle and prove walks the whole chain, windowed dumps count
+    //the Blocks of their window themselves
+    if (command != "merkle" && command != "prove" &&
+        !(isWindowed && (command == "format" || command == "hash"))) {
+        StatsAddBlocks(LedgerSize(*blockChain.ledger));
+    }
+    //the target file is the input file
+    if (command == "verify") 
+    {
+        ifstream target(path);
+        if (target.is_open())
         {
-            auto* blockChain = new BlockChain();
-            *blockChain = BlockChainLoad(source);
-            //the target file is the input file
-            if (command == "verify") 
+            int mismatch;
+            bool isVerified = BlockChainVerifyFileParallel(blockChain, target,
+                options.threads, mismatch);
+            out << "Verification " << (isVerified ? "passed" : "failed") << std::endl;
+            if (mismatch != 0) {
+                err << "First mismatching block: " << mismatch << std::endl;
+            }
+            StatsAddBytesRead(target.rdbuf()->pubseekoff(0, std::ios::cur,
+                std::ios::in));
+        }else{
+            return 1;
+        }
+    }else{
+        //the target file is the output file
+        ofstream target(path, command == "convert" ?
+            std::ios::out | std::ios::binary : std::ios::out);
+        if (target.is_open())
+        {
+            if (command == "format" && isWindowed)
             {
-                ifstream target(argv[FILE_2]);
-                if (target.is_open())
-                {
-                    bool isVerified = BlockChainVerifyFile(*blockChain, target);
-                    std::cout << "Verification " << (isVerified ? "passed" : "failed") << std::endl;
-                    blockChain->deleteBlockChain(blockChain);
-                }else{
-                    blockChain->deleteBlockChain(blockChain);
+                BlockChainDumpWindow(blockChain, options.from, options.to, target);
+            }
+            else if (command == "format") 
+            {
+                BlockChainDump(blockChain, target);
+            }
+            else if (command == "hash" && isWindowed)
+            {
+                BlockChainDumpHashedWindow(blockChain, options.from, options.to,
+                    target);
+            }
+            else if (command == "hash") 
+            {
+                BlockChainDumpHashedParallel(blockChain, target, options.threads);
+            }
+            else if (command == "compress") 
+            {
+                BlockChainCompressParallel(blockChain, options.threads);
+                BlockChainDump(blockChain, target);
+            }
+            else if (command == "convert")
+            {
+                if (!BlockChainSaveBinary(blockChain, target)) {
                     return 1;
                 }
-            }else{
-                //the target file is the output file
-                ofstream target(argv[FILE_2]);
-                if (target.is_open())
-                {
-                    if (command == "format") 
-                    {
-                        BlockChainDump(*blockChain, target);
-                    }
-                    else if (command == "hash") 
-                    {
-                        BlockChainDumpHashed(*blockChain, target);
-                    }
-                    else if (command == "compress") 
-                    {
-                        BlockChainCompress(*blockChain);
-                        BlockChainDump(*blockChain, target);
-                    }
-                    else 
-                    {
-                        std::cout << getErrorMessage() << std::endl;
-                    }
-                    blockChain->deleteBlockChain(blockChain);
-                }else{
-                    blockChain->deleteBlockChain(blockChain);
+            }
+            else if (command == "merkle")
+            {
+                writeMerkleRoot(merkle, target);
+            }
+            else if (command == "prove")
+            {
+                if (!writeMerkleProof(merkle, blockChain, block, target)) {
+                    err << "No block " << block << std::endl;
                     return 1;
                 }
-                
             }
+            else if (command == "counterparties" || command == "netflow" || command == "cycle")
+            {
+                //counterparties needs an account and netflow two of them
+                if ((command != "cycle" && options.account.empty()) ||
+                    (command == "netflow" && options.other.empty())) {
+                    out << getErrorMessage() << std::endl;
+                    return 1;
+                }
+                //Looked up rather than converted, so a mistyped name is not interned
+                AccountName account;
+                AccountName other;
+                if (command != "cycle" && !findAccount(options.account, account, err)) {
+                    return 1;
+                }
+                if (command == "netflow" && !findAccount(options.other, other, err)) {
+                    return 1;
+                }
+                AccountGraph graph;
+                AccountGraphBuild(graph, blockChain);
+                if (command == "counterparties") {
+                    writeCounterparties(graph, account, options.count, target);
+                }
+                else if (command == "netflow") {
+                    writeNetFlow(graph, account, other, target);
+                }
+                else {
+                    writeCycle(graph, target);
+                }
+            }
+            else 
+            {
+                out << getErrorMessage() << std::endl;
+            }
+            StatsAddBytesWritten(target.tellp());
         }else{
+            return 1;
+        }
+    }
+    return 0;
+}
+
+//One line of a batch script: a command, its target and the Block prove works on
+struct BatchCommand {
+    string command;
+    string target;
+    int block;
+};
+
+//Reads "<command> <target> [block]" lines, skipping blank lines and lines starting with #
+bool readBatch(const char* path, const int block, std::vector<BatchCommand>& commands)
+{
+    static const char* const COMMANDS[] = {"verify", "format", "hash", "compress",
+        "convert", "merkle", "prove", "counterparties", "netflow", "cycle"};
+    ifstream script(path);
+    if (!script.is_open()) {
+        return false;
+    }
+    string line;
+    while (getline(script, line)) {
+        std::istringstream fields(line);
+        BatchCommand command = {"", "", block};
+        if (!(fields >> command.command) || command.command[0] == '#') {
+            continue;
+        }
+        fields >> command.target;
+        string proved;
+        if (command.command == "prove" && fields >> proved) {
+            command.block = std::atoi(proved.c_str());
+        }
+        string extra;
+        if (std::find(std::begin(COMMANDS), std::end(COMMANDS), command.command) ==
+            std::end(COMMANDS) || command.target.empty() || command.block < 1 ||
+            fields >> extra) {
+            return false;
+        }
+        commands.push_back(command);
+    }
+    return true;
+}
+
+//Compress is the only command that changes the chain
+bool isMutating(const BatchCommand& command)
+{
+    return command.command == "compress";
+}
+
+//Verify reads its target, every other command writes it
+bool isWriting(const BatchCommand& command)
+{
+    return command.command != "verify";
+}
+
+//Tells whether two targets name the same file, whether or not it exists yet
+bool isSameFile(const string& first, const string& second)
+{
+    std::error_code error;
+    const std::filesystem::path firstPath = std::filesystem::weakly_canonical(first, error);
+    const std::filesystem::path secondPath = std::filesystem::weakly_canonical(second, error);
+    return error ? first == second : firstPath == secondPath;
+}
+
+//Tells whether a command uses a file that one of the commands in [first, last) writes,
+//or writes a file one of them uses, so it cannot run together with them
+bool isConflicting(const std::vector<BatchCommand>& commands, const size_t first,
+    const size_t last, const BatchCommand& command)
+{
+    for (size_t i = first; i < last; i++) {
+        if ((isWriting(commands[i]) || isWriting(command)) &&
+            isSameFile(commands[i].target, command.target)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//Runs the script in order. A run of commands that leave the chain as it is, and
+//whose files do not overlap, runs concurrently, and their messages are printed in
+//script order once all of them end
+int runBatch(const std::vector<BatchCommand>& commands, BlockChain& blockChain,
+    const MerkleTree& merkle, const Options& options)
+{
+    int status = 0;
+    size_t first = 0;
+    while (first < commands.size()) {
+        size_t last = first + 1;
+        //A group shares the chain across threads, which is safe because every command but
+        //compress only reads it and the indexes of its Ledger: windowed ones scan the chain
+        //rather than rebuild a stale TimeIndex, and only compress rebuilds the Merkle tree
+        while (!isMutating(commands[first]) && last < commands.size() &&
+            !isMutating(commands[last]) && !isConflicting(commands, first, last, commands[last])) {
+            last++;
+        }
+        string name = commands[first].command;
+        for (size_t i = first + 1; i < last; i++) {
+            name += "+" + commands[i].command;
+        }
+        StatsScope phase(name.c_str());
+        const size_t count = last - first;
+        std::vector<std::ostringstream> outs(count);
+        std::vector<std::ostringstream> errs(count);
+        std::vector<int> results(count);
+        if (count == 1) {
+            results[0] = runCommand(commands[first].command, commands[first].target.c_str(),
+                blockChain, merkle, options, commands[first].block, outs[0], errs[0]);
+        }
+        else {
+            ThreadPool pool(count);
+            std::vector<std::future<int>> pending;
+            for (size_t i = 0; i < count; i++) {
+                const BatchCommand& command = commands[first + i];
+                std::ostringstream& out = outs[i];
+                std::ostringstream& err = errs[i];
+                pending.push_back(ThreadPoolAsync(pool,
+                    [&command, &blockChain, &merkle, &options, &out, &err]() {
+                        return runCommand(command.command, command.target.c_str(),
+                            blockChain, merkle, options, command.block, out, err);
+                    }));
+            }
+            for (size_t i = 0; i < count; i++) {
+                results[i] = pending[i].get();
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            std::cout << outs[i].str();
+            std::cerr << errs[i].str();
+            if (results[i] != 0) {
+                std::cerr << "Failed: " << commands[first + i].command << " "
+                    << commands[first + i].target << std::endl;
+                status = 1;
+            }
+        }
+        first = last;
+    }
+    return status;
+}
+
+//Compresses a text source straight into the target, failing the way a loaded compress does
+int runStreamingCompress(const char* sourcePath, const char* targetPath)
+{
+    StatsScope phase("compress");
+    ifstream source(sourcePath, std::ios::binary);
+    if (!source.is_open()) {
+        std::cout << getErrorMessage() << std::endl;
+        return 1;
+    }
+    ofstream target(targetPath);
+    if (!target.is_open()) {
+        return 1;
+    }
+    BlockChainCompressStream(source, target);
+    StatsAddBytesWritten(target.tellp());
+    return 0;
+}
+
+//Registered with atexit, so it runs after every phase of main has ended
+void reportStats()
+{
+    StatsReport(std::cerr);
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cout << getErrorMessage() << std::endl;
+        return 1;
+    }
+    if (options.stats) {
+        StatsEnable();
+        std::atexit(reportStats);
+    }
+    const bool isWindowed = !options.from.empty() || !options.to.empty();
+    if (isWindowed && (TimeIndexParse(options.from) == TimeIndex::INVALID_TIME ||
+        TimeIndexParse(options.to) == TimeIndex::INVALID_TIME)) {
+        std::cout << getErrorMessage() << std::endl;
+        return 1;
+    }
+    argc = options.arguments.size();
+    argv = options.arguments.data();
+    if (argc == ARGS_COUNT) {
+        const string command = argv[COMMAND];
+        //batch runs every command listed in the second file against one load of the chain
+        std::vector<BatchCommand> commands;
+        if (command == "batch") {
+            if (!readBatch(argv[FILE_2], options.block, commands)) {
+                std::cout << getErrorMessage() << std::endl;
+                return 1;
+            }
+        }
+        else {
+            commands.push_back({command, argv[FILE_2], options.block});
+        }
+        if (command == "compress" && options.stream && !BlockChainIsBinary(argv[FILE_1]) &&
+            !CheckpointIsCheckpoint(argv[FILE_1]) && !TransactionLogIsLog(argv[FILE_1])) {
+            return runStreamingCompress(argv[FILE_1], argv[FILE_2]);
+        }
+        Ledger ledger;
+        MerkleTree merkle;
+        for (const BatchCommand& listed : commands) {
+            if (listed.command == "merkle" || listed.command == "prove") {
+                LedgerAttachMerkle(ledger, &merkle);
+                break;
+            }
+        }
+        //Sources written by convert and checkpoints are read back as they are, transaction
+        //logs are replayed, and anything else, or any of those that fails to load, is
+        //parsed as text, since a text ledger may happen to start like one of them
+        BlockChain* blockChain = nullptr;
+        TimeIndex times;
+        {
+            StatsScope phase("load");
+            if (BlockChainIsBinary(argv[FILE_1])) {
+                blockChain = BlockChainLoadBinary(argv[FILE_1], ledger);
+            }
+            else if (CheckpointIsCheckpoint(argv[FILE_1])) {
+                long long position;
+                blockChain = CheckpointLoad(argv[FILE_1], ledger, position);
+            }
+            else if (TransactionLogIsLog(argv[FILE_1]) &&
+                TransactionLogReplay(argv[FILE_1], LedgerHead(ledger)) >= 0) {
+                blockChain = &LedgerHead(ledger);
+            }
+            if (blockChain == nullptr) {
+                blockChain = BlockChainLoadParallel(argv[FILE_1], ledger, options.threads);
+            }
+            //Built once over the whole source, so that no command ever finds it stale: a
+            //replayed log may go back in time, and windowed queries do not rebuild it
+            if (blockChain != nullptr && isWindowed) {
+                LedgerAttachTimes(ledger, &times);
+            }
+            StatsAddBlocks(LedgerSize(ledger));
+        }
+        if (blockChain == nullptr) {
             std::cout << getErrorMessage() << std::endl;
             return 1;
         }
+        if (command == "batch") {
+            return runBatch(commands, *blockChain, merkle, options);
+        }
+        StatsScope phase(command.c_str());
+        return runCommand(command, argv[FILE_2], *blockChain, merkle, options,
+            options.block, std::cout, std::cerr);
     } else {
         std::cout << getErrorMessage() << std::endl;
     }
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+
+#include "../AccountGraph.h"
+#include "../BlockChain.h"
+#include "TestUtil.h"
+
+
+static const int BLOCKS = 10007;
+static const int NAMES = 40;
+
+int main()
+{
+    int test = 0;
+    std::mt19937 random(4242);
+    Ledger ledger;
+    BlockChain& blockChain = LedgerHead(ledger);
+    std::map<std::pair<unsigned int, unsigned int>, unsigned long long> sent;
+    for (int i = 0; i < BLOCKS; i++) {
+        const unsigned int value = random() % 1000;
+        const AccountName sender = "g" + std::to_string(random() % NAMES);
+        const AccountName receiver = "g" + std::to_string(random() % NAMES);
+        BlockChainAppendTransaction(blockChain, value, sender.name(), receiver.name(),
+            std::to_string(i));
+        sent[{sender.id, receiver.id}] += value;
+    }
+    AccountGraph graph;
+    AccountGraphBuild(graph, blockChain);
+
+    // Test 1: every pair of accounts is one edge holding the total they sent
+    ASSERT_TEST(AccountGraphEdges(graph) == static_cast<int>(sent.size()));
+    for (const auto& edge : sent) {
+        AccountName sender;
+        AccountName receiver;
+        sender.id = edge.first.first;
+        receiver.id = edge.first.second;
+        ASSERT_TEST(AccountGraphSent(graph, sender, receiver) == edge.second);
+        ASSERT_TEST(AccountGraphNetFlow(graph, receiver, sender) ==
+            static_cast<long long>(edge.second) -
+            static_cast<long long>(AccountGraphSent(graph, receiver, sender)));
+    }
+    ASSERT_TEST(AccountGraphSent(graph, "g0", "nobody") == 0);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 2: top counterparties match a plain count over the chain
+    const AccountName account = "g7";
+    std::map<unsigned int, unsigned long long> exchanged;
+    for (const auto& edge : sent) {
+        if (edge.first.first == account.id) {
+            exchanged[edge.first.second] += edge.second;
+        }
+        if (edge.first.second == account.id) {
+            exchanged[edge.first.first] += edge.second;
+        }
+    }
+    const std::vector<Counterparty> top = AccountGraphTopCounterparties(graph, account, 5);
+    ASSERT_TEST(top.size() == 5);
+    for (size_t i = 0; i < top.size(); i++) {
+        ASSERT_TEST(top[i].sent + top[i].received == exchanged[top[i].account.id]);
+        ASSERT_TEST(top[i].sent == AccountGraphSent(graph, account, top[i].account));
+        ASSERT_TEST(i == 0 ||
+            top[i - 1].sent + top[i - 1].received >= top[i].sent + top[i].received);
+    }
+    for (const auto& other : exchanged) {
+        ASSERT_TEST(other.second <= top.back().sent + top.back().received ||
+            std::any_of(top.begin(), top.end(), [&other](const Counterparty& entry) {
+                return entry.account.id == other.first;
+            }));
+    }
+    ASSERT_TEST(AccountGraphTopCounterparties(graph, account, NAMES * 2).size() ==
+        exchanged.size());
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 3: transfers that only go up a ladder have no cycle, one back step makes one
+    Ledger ladderLedger;
+    BlockChain& ladder = LedgerHead(ladderLedger);
+    for (int i = 0; i < 50; i++) {
+        BlockChainAppendTransaction(ladder, 1, "r" + std::to_string(i),
+            "r" + std::to_string(i + 1 + random() % 3), std::to_string(i));
+    }
+    AccountGraphBuild(graph, ladder);
+    ASSERT_TEST(AccountGraphFindCycle(graph).empty());
+    BlockChainAppendTransaction(ladder, 1, "r40", "r10", "back");
+    AccountGraphBuild(graph, ladder);
+    const std::vector<AccountName> cycle = AccountGraphFindCycle(graph);
+    ASSERT_TEST(!cycle.empty());
+    for (size_t i = 0; i < cycle.size(); i++) {
+        ASSERT_TEST(AccountGraphSent(graph, cycle[i], cycle[(i + 1) % cycle.size()]) > 0);
+    }
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+    return 0;
+}
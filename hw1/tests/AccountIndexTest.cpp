@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../AccountIndex.h"
+#include "../BlockChain.h"
+#include "TestUtil.h"
+
+
+static const char* SOURCE_PATH = "AccountIndexTest.source";
+static const int BLOCKS = 20000;
+static const int NAMES = 12;
+static const int THREADS = 4;
+
+string randomName(std::mt19937& random)
+{
+    return "i" + std::to_string(random() % NAMES);
+}
+
+//Sums the balance of an account over the chain, as it was before the index
+int scannedBalance(const BlockChain& blockChain, const string& name)
+{
+    int balance = 0;
+    for (const BlockChain* current = &blockChain;
+        current != nullptr && BlockChainIsOccupied(*current);
+        current = current->next) {
+        if (current->transaction.receiver.name() == name) {
+            balance += current->transaction.value;
+        }
+        if (current->transaction.sender.name() == name) {
+            balance -= current->transaction.value;
+        }
+    }
+    return balance;
+}
+
+//Compares every balance read from the index with a scan of the chain
+void sameBalances(Ledger& ledger)
+{
+    BlockChain& blockChain = LedgerHead(ledger);
+    for (int name = 0; name < NAMES; name++) {
+        const string account = "i" + std::to_string(name);
+        ASSERT_TEST(BlockChainPersonalBalance(blockChain, account) ==
+            scannedBalance(blockChain, account));
+    }
+    ASSERT_TEST(BlockChainPersonalBalance(blockChain, "nobody") == 0);
+}
+
+int main()
+{
+    int test = 0;
+    std::mt19937 random(31337);
+    Ledger ledger;
+    AccountIndex index;
+    LedgerAttachIndex(ledger, &index);
+    BlockChain& blockChain = LedgerHead(ledger);
+
+    // Test 1: appends at the head are added to the index
+    for (int i = 0; i < BLOCKS; i++) {
+        //Runs of the same pair, so that compress has something to merge
+        const string sender = randomName(random);
+        const string receiver = randomName(random);
+        for (int run = random() % 3; run >= 0; run--) {
+            BlockChainAppendTransaction(blockChain, random() % 1000, sender, receiver,
+                std::to_string(i));
+        }
+    }
+    sameBalances(ledger);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 2: transforms of the whole chain and of a range of ranks adjust it
+    BlockChainTransform(blockChain, TimesTwo);
+    sameBalances(ledger);
+    BlockChainTransformRange(blockChain, 100, 5000, [](const unsigned int value) {
+        return value / 3;
+    });
+    sameBalances(ledger);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 3: compress, serial and parallel, leaves it in step
+    BlockChainCompress(blockChain);
+    sameBalances(ledger);
+    for (int i = 0; i < BLOCKS; i++) {
+        BlockChainAppendTransaction(blockChain, random() % 1000, randomName(random),
+            randomName(random), "again");
+    }
+    BlockChainCompressParallel(blockChain, THREADS);
+    sameBalances(ledger);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 4: a parallel load fills the index attached beforehand
+    {
+        std::ofstream source(SOURCE_PATH);
+        for (int i = 0; i < BLOCKS; i++) {
+            source << randomName(random) << " " << randomName(random) << " "
+                << random() % 1000 << " " << i << std::endl;
+        }
+    }
+    Ledger loaded;
+    AccountIndex loadedIndex;
+    LedgerAttachIndex(loaded, &loadedIndex);
+    ASSERT_TEST(BlockChainLoadParallel(SOURCE_PATH, loaded, THREADS) != nullptr);
+    ASSERT_TEST(LedgerSize(loaded) == BLOCKS);
+    sameBalances(loaded);
+    std::remove(SOURCE_PATH);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../BlockChain.h"
+#include "../Checkpoint.h"
+#include "../ConcurrentChain.h"
+#include "../TransactionLog.h"
+#include "TestUtil.h"
+
+
+static const char* CHECKPOINT_PATH = "CheckpointTest.ckpt";
+static const char* LOG_PATH = "CheckpointTest.log";
+static const int BLOCKS = 5000;
+static const int TAIL = 3000;
+static const int BATCH_SIZE = 64;
+
+void append(ConcurrentChain& chain, const int i)
+{
+    ConcurrentChainAppend(chain, makeTransaction(i), std::to_string(i));
+}
+
+int main()
+{
+    int test = 0;
+    std::remove(CHECKPOINT_PATH);
+    std::remove(LOG_PATH);
+
+    // Test 1: a checkpoint reads back as the chain and the position it was written with
+    Ledger ledger;
+    for (int i = 0; i < 100; i++) {
+        BlockChainAppendTransaction(LedgerHead(ledger), i, "a", "b", std::to_string(i));
+    }
+    ASSERT_TEST(CheckpointWrite(LedgerHead(ledger), 42, CHECKPOINT_PATH));
+    ASSERT_TEST(CheckpointIsCheckpoint(CHECKPOINT_PATH));
+    Ledger loaded;
+    long long position = 0;
+    const BlockChain* head = CheckpointLoad(CHECKPOINT_PATH, loaded, position);
+    ASSERT_TEST(head != nullptr && position == 42);
+    ASSERT_TEST(sameChain(*head, LedgerHead(ledger)));
+    std::remove(CHECKPOINT_PATH);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 2: the checkpointer saves the chain while appends go on
+    ConcurrentChain chain;
+    TransactionLog log;
+    ASSERT_TEST(TransactionLogOpen(log, LOG_PATH, BATCH_SIZE));
+    ConcurrentChainAttachLog(chain, &log);
+    Checkpointer checkpointer;
+    CheckpointerStart(checkpointer, chain, CHECKPOINT_PATH, std::chrono::milliseconds(5));
+    for (int i = 0; i < BLOCKS; i++) {
+        append(chain, i);
+        if (i % 1000 == 0) {
+            CheckpointerRequest(checkpointer);
+        }
+    }
+    CheckpointerStop(checkpointer);
+    ASSERT_TEST(CheckpointerWritten(checkpointer) == BLOCKS);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 3: a restart loads the checkpoint and replays only the appends that followed it
+    for (int i = BLOCKS; i < BLOCKS + TAIL; i++) {
+        append(chain, i);
+    }
+    ASSERT_TEST(TransactionLogClose(log));
+    ConcurrentChain restored;
+    ASSERT_TEST(CheckpointRestore(restored, CHECKPOINT_PATH, LOG_PATH) == BLOCKS + TAIL);
+    ASSERT_TEST(sameChain(*ConcurrentChainRead(restored).head, *ConcurrentChainRead(chain).head));
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 4: without a checkpoint the whole log is replayed, a damaged checkpoint is refused
+    std::remove(CHECKPOINT_PATH);
+    ConcurrentChain replayed;
+    ASSERT_TEST(CheckpointRestore(replayed, CHECKPOINT_PATH, LOG_PATH) == BLOCKS + TAIL);
+    ASSERT_TEST(sameChain(*ConcurrentChainRead(replayed).head, *ConcurrentChainRead(chain).head));
+    std::ofstream(CHECKPOINT_PATH) << "HW1C but not really";
+    ConcurrentChain refused;
+    ASSERT_TEST(CheckpointRestore(refused, CHECKPOINT_PATH, LOG_PATH) == -1);
+    std::remove(CHECKPOINT_PATH);
+    std::remove(LOG_PATH);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../BlockChain.h"
+#include "TestUtil.h"
+
+
+static const int BLOCKS = 200000;
+static const int THREADS = 4;
+static const char* SOURCE_PATH = "CompressTest.source";
+static const char* LOADED_PATH = "CompressTest.loaded";
+static const char* STREAMED_PATH = "CompressTest.streamed";
+
+//Appends the same random transactions to both chains, in runs of random length
+void fillChains(std::mt19937& random, BlockChain& first, BlockChain& second,
+    const int names, const int maxRun)
+{
+    for (int i = 0; i < BLOCKS;) {
+        const string sender = "s" + std::to_string(random() % names);
+        const string receiver = "r" + std::to_string(random() % names);
+        const int run = 1 + random() % maxRun;
+        for (int j = 0; j < run && i < BLOCKS; j++, i++) {
+            const unsigned int value = random();
+            BlockChainAppendTransaction(first, value, sender, receiver, "t");
+            BlockChainAppendTransaction(second, value, sender, receiver, "t");
+        }
+    }
+}
+
+void testCompress(std::mt19937& random, const int names, const int maxRun)
+{
+    Ledger serial;
+    Ledger parallel;
+    fillChains(random, LedgerHead(serial), LedgerHead(parallel), names, maxRun);
+    BlockChainCompress(LedgerHead(serial));
+    BlockChainCompressParallel(LedgerHead(parallel), THREADS);
+    ASSERT_TEST(sameChain(LedgerHead(serial), LedgerHead(parallel)));
+    ASSERT_TEST(LedgerSize(serial) == LedgerSize(parallel));
+    const BlockChain* last = &LedgerHead(parallel);
+    while (last->next != nullptr) {
+        last = last->next;
+    }
+    ASSERT_TEST(&LedgerTail(parallel) == last);
+}
+
+//Writes random lines in runs, long enough for the file to span several chunks of the stream
+void writeSource(std::mt19937& random, const int names, const int maxRun)
+{
+    ofstream file(SOURCE_PATH);
+    for (int i = 0; i < BLOCKS;) {
+        const string sender = "sender" + std::to_string(random() % names);
+        const string receiver = "receiver" + std::to_string(random() % names);
+        const int run = 1 + random() % maxRun;
+        for (int j = 0; j < run && i < BLOCKS; j++, i++) {
+            file << sender << " " << receiver << " " << random() % 1000 << " t" << i << "\n";
+        }
+    }
+}
+
+void testCompressStream(std::mt19937& random, const int names, const int maxRun)
+{
+    writeSource(random, names, maxRun);
+    {
+        ifstream source(SOURCE_PATH);
+        Ledger ledger;
+        BlockChain& blockChain = BlockChainLoad(source, ledger);
+        BlockChainCompress(blockChain);
+        ofstream target(LOADED_PATH);
+        BlockChainDump(blockChain, target);
+    }
+    {
+        ifstream source(SOURCE_PATH, std::ios::binary);
+        ofstream target(STREAMED_PATH);
+        BlockChainCompressStream(source, target);
+    }
+    ASSERT_TEST(readFile(LOADED_PATH) == readFile(STREAMED_PATH));
+    std::remove(SOURCE_PATH);
+    std::remove(LOADED_PATH);
+    std::remove(STREAMED_PATH);
+}
+
+int main()
+{
+    int test = 0;
+    std::mt19937 random(8675309);
+    // Test 1: short runs over few names, so neighbouring runs often match too
+    testCompress(random, 2, 4);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 2: runs longer than a whole segment
+    testCompress(random, 3, BLOCKS / 3);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 3: a single run over the whole chain
+    testCompress(random, 1, 1);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 4: nothing to merge
+    testCompress(random, 1000, 1);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 5: streaming from the file writes what loading and compressing writes
+    testCompressStream(random, 2, 4);
+    testCompressStream(random, 1000, 1);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+    return 0;
+}
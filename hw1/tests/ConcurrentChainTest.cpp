@@ -0,0 +1,79 @@
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../ConcurrentChain.h"
+#include "TestUtil.h"
+
+
+static const int BLOCKS = 20000;
+static const int READERS = 3;
+
+int main()
+{
+    int test = 0;
+    ConcurrentChain chain;
+
+    // Test 1: an empty chain reads as an empty Block
+    ConcurrentChainSnapshot snapshot = ConcurrentChainRead(chain);
+    ASSERT_TEST(snapshot.size == 0 && !BlockChainIsOccupied(*snapshot.head));
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 2: readers scanning while a writer appends always see a whole prefix
+    std::atomic<bool> isWriting(true);
+    std::atomic<bool> isConsistent(true);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; r++) {
+        readers.emplace_back([&chain, &isWriting, &isConsistent]() {
+            int lastSize = 0;
+            while (isWriting) {
+                const ConcurrentChainSnapshot current = ConcurrentChainRead(chain);
+                if (current.size < lastSize) {
+                    isConsistent = false;
+                }
+                lastSize = current.size;
+                if (current.size == 0) {
+                    continue;
+                }
+                //Block i sends i to the reader account, and the newest Block is the head
+                if (BlockChainGetSize(*current.head) != current.size ||
+                    BlockChainPersonalBalance(*current.head, "reader") !=
+                    current.size * (current.size - 1) / 2 ||
+                    current.head->timestamp.text() != std::to_string(current.size - 1)) {
+                    isConsistent = false;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < BLOCKS; i++) {
+        ConcurrentChainAppend(chain, i, "writer", "reader", std::to_string(i));
+    }
+    isWriting = false;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    ASSERT_TEST(isConsistent);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 3: the final snapshot holds every Block, newest first
+    snapshot = ConcurrentChainRead(chain);
+    ASSERT_TEST(snapshot.size == BLOCKS);
+    int expected = BLOCKS - 1;
+    for (const BlockChain* current = snapshot.head; current != nullptr;
+        current = current->next, expected--) {
+        ASSERT_TEST(current->timestamp.text() == std::to_string(expected));
+        ASSERT_TEST(current->transaction.value == static_cast<unsigned int>(expected));
+    }
+    ASSERT_TEST(expected == -1);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 4: a snapshot cannot be freed from under the chain
+    BlockChain::deleteBlockChain(snapshot.head);
+    ConcurrentChainAppend(chain, BLOCKS, "writer", "reader", std::to_string(BLOCKS));
+    snapshot = ConcurrentChainRead(chain);
+    ASSERT_TEST(snapshot.size == BLOCKS + 1 && BlockChainGetSize(*snapshot.head) == BLOCKS + 1);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../HashKernels.h"
+#include "TestUtil.h"
+
+
+static const int ROUNDS = 20000;
+static const int MAX_NAME_LENGTH = 300;
+
+std::string randomName(std::mt19937& random)
+{
+    std::string name(random() % MAX_NAME_LENGTH, '\0');
+    for (char& character : name) {
+        //Any byte value, including negative chars and separators
+        character = static_cast<char>(random());
+    }
+    return name;
+}
+
+void testKernel(HashKernel kernel)
+{
+    std::mt19937 random(234124);
+    for (int round = 0; round < ROUNDS; round++) {
+        const int key = static_cast<int>(random());
+        const std::string sender = randomName(random);
+        const std::string receiver = randomName(random);
+        ASSERT_TEST(kernel(key, sender, receiver) == hashScalar(key, sender, receiver));
+    }
+}
+
+int main()
+{
+    int test = 0;
+    // Test 1: known digest from tests/hash.target.expected
+    ASSERT_TEST(hashScalar(30, "baraa", "regev") == "07214b658f243aad98fd");
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 2: SSE2 kernel matches the scalar one
+    testKernel(hashSse2);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 3: AVX2 kernel matches the scalar one
+    if (hashAvx2Supported()) {
+        testKernel(hashAvx2);
+    }
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 4: the dispatched kernel matches the scalar one
+    testKernel(hashBestKernel());
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+    return 0;
+}
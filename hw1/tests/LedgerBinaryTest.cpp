@@ -0,0 +1,65 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../BlockChain.h"
+#include "../Checkpoint.h"
+#include "TestUtil.h"
+
+
+static const char* BINARY_PATH = "LedgerBinaryTest.bin";
+static const char* TEXT_PATH = "LedgerBinaryTest.txt";
+
+//Writes a text ledger whose first line starts with a given prefix
+void writeText(const string& prefix)
+{
+    std::ofstream file(TEXT_PATH, std::ios::binary);
+    file << prefix << "x b 5 10:00\n" << "a b 7 10:01\n";
+}
+
+int main()
+{
+    int test = 0;
+
+    // Test 1: a converted ledger is detected and reads back as the same chain
+    Ledger ledger;
+    for (int i = 0; i < 100; i++) {
+        BlockChainAppendTransaction(LedgerHead(ledger), makeTransaction(i), std::to_string(i));
+    }
+    {
+        std::ofstream file(BINARY_PATH, std::ios::binary);
+        ASSERT_TEST(BlockChainSaveBinary(LedgerHead(ledger), file));
+    }
+    ASSERT_TEST(BlockChainIsBinary(BINARY_PATH));
+    ASSERT_TEST(!CheckpointIsCheckpoint(BINARY_PATH));
+    Ledger loaded;
+    const BlockChain* head = BlockChainLoadBinary(BINARY_PATH, loaded);
+    ASSERT_TEST(head != nullptr && sameChain(*head, LedgerHead(ledger)));
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 2: a binary ledger cut short is not taken for one
+    const string image = readFile(BINARY_PATH);
+    {
+        std::ofstream file(BINARY_PATH, std::ios::binary);
+        file.write(image.data(), image.size() - 1);
+    }
+    ASSERT_TEST(!BlockChainIsBinary(BINARY_PATH));
+    std::remove(BINARY_PATH);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 3: text ledgers that start with a magic are still parsed as text
+    for (const char* prefix : {"HW1L", "HW1C"}) {
+        writeText(prefix);
+        ASSERT_TEST(!BlockChainIsBinary(TEXT_PATH));
+        ASSERT_TEST(!CheckpointIsCheckpoint(TEXT_PATH));
+        Ledger text;
+        const BlockChain* first = BlockChainLoadParallel(TEXT_PATH, text, 1);
+        ASSERT_TEST(first != nullptr && LedgerSize(text) == 2);
+        ASSERT_TEST(first->transaction.sender.name() == string(prefix) + "x");
+    }
+    std::remove(TEXT_PATH);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+
+#include "../BlockChain.h"
+#include "../LedgerColumns.h"
+#include "TestUtil.h"
+
+
+static const int BLOCKS = 10007;
+static const int NAMES = 40;
+
+int main()
+{
+    int test = 0;
+    std::mt19937 random(31337);
+    Ledger ledger;
+    BlockChain& blockChain = LedgerHead(ledger);
+    for (int i = 0; i < BLOCKS; i++) {
+        BlockChainAppendTransaction(blockChain, random(),
+            "c" + std::to_string(random() % NAMES), "c" + std::to_string(random() % NAMES),
+            std::to_string(i));
+    }
+    LedgerColumns columns;
+    LedgerColumnsFromChain(columns, blockChain);
+
+    // Test 1: converting back gives the same chain
+    Ledger copy;
+    const BlockChain* original = &blockChain;
+    const BlockChain* converted = &LedgerColumnsToChain(columns, copy);
+    const BlockChain* last = converted;
+    for (; original != nullptr && converted != nullptr;
+        original = original->next, converted = converted->next) {
+        last = converted;
+        ASSERT_TEST(original->transaction.value == converted->transaction.value);
+        ASSERT_TEST(original->transaction.sender == converted->transaction.sender);
+        ASSERT_TEST(original->transaction.receiver == converted->transaction.receiver);
+        ASSERT_TEST(original->timestamp == converted->timestamp);
+    }
+    ASSERT_TEST(original == nullptr && converted == nullptr);
+    ASSERT_TEST(LedgerSize(copy) == BLOCKS && &LedgerTail(copy) == last);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 2: balances match the chain's
+    const std::vector<AccountBalance> balances = LedgerColumnsBalances(columns);
+    const std::vector<AccountBalance> expected = BlockChainAllBalances(blockChain);
+    ASSERT_TEST(balances.size() == expected.size());
+    for (size_t i = 0; i < balances.size(); i++) {
+        ASSERT_TEST(balances[i].account == expected[i].account);
+        ASSERT_TEST(balances[i].balance == expected[i].balance);
+        ASSERT_TEST(LedgerColumnsBalance(columns, balances[i].account) ==
+            BlockChainPersonalBalance(blockChain, balances[i].account.name()));
+    }
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 3: volume and top senders match a plain count over the chain
+    unsigned long long volume = 0;
+    std::map<unsigned int, unsigned long long> sent;
+    for (const BlockChain* current = &blockChain; current != nullptr; current = current->next) {
+        volume += current->transaction.value;
+        sent[current->transaction.sender.id] += current->transaction.value;
+    }
+    ASSERT_TEST(LedgerColumnsVolume(columns) == volume);
+    const std::vector<AccountVolume> top = LedgerColumnsTopSenders(columns, 5);
+    ASSERT_TEST(top.size() == 5);
+    for (size_t i = 0; i < top.size(); i++) {
+        ASSERT_TEST(top[i].volume == sent[top[i].account.id]);
+        ASSERT_TEST(i == 0 || top[i - 1].volume >= top[i].volume);
+    }
+    for (const auto& sender : sent) {
+        ASSERT_TEST(sender.second <= top.back().volume ||
+            std::any_of(top.begin(), top.end(), [&sender](const AccountVolume& entry) {
+                return entry.account.id == sender.first;
+            }));
+    }
+    ASSERT_TEST(LedgerColumnsTopSenders(columns, NAMES * 2).size() == sent.size());
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+    return 0;
+}
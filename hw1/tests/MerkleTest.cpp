@@ -0,0 +1,61 @@
+#include <iostream>
+#include <string>
+
+#include "../BlockChain.h"
+#include "../MerkleTree.h"
+#include "TestUtil.h"
+
+
+static const int BLOCKS = 300;
+
+bool sameTree(const MerkleTree& first, const MerkleTree& second)
+{
+    return MerkleTreeSize(first) == MerkleTreeSize(second) &&
+        MerkleTreeRoot(first) == MerkleTreeRoot(second);
+}
+
+int main()
+{
+    int test = 0;
+    // Test 1: SHA-256 of "abc" from FIPS 180-2
+    ASSERT_TEST(sha256Hex(sha256(reinterpret_cast<const unsigned char*>("abc"), 3)) ==
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 2: appending at the head keeps the tree equal to a full rebuild
+    Ledger ledger;
+    MerkleTree merkle;
+    LedgerAttachMerkle(ledger, &merkle);
+    BlockChain& blockChain = LedgerHead(ledger);
+    for (int i = 0; i < BLOCKS; i++) {
+        BlockChainAppendTransaction(blockChain, makeTransaction(i), "t" + std::to_string(i));
+        MerkleTree rebuilt;
+        MerkleTreeBuild(rebuilt, blockChain);
+        ASSERT_TEST(sameTree(merkle, rebuilt));
+    }
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 3: every Block has a proof, and the proof fails for another Block
+    const Sha256Digest root = MerkleTreeRoot(merkle);
+    int rank = 1;
+    for (const BlockChain* current = &blockChain; current != nullptr;
+        current = current->next, rank++) {
+        const std::vector<MerkleProofStep> proof =
+            MerkleTreeProve(merkle, MerkleTreeLeafOfRank(merkle, rank));
+        ASSERT_TEST(proof.size() <= 9);
+        ASSERT_TEST(MerkleTreeVerifyProof(root,
+            TransactionHashedMessage(current->transaction), proof));
+        Transaction forged = current->transaction;
+        forged.value++;
+        ASSERT_TEST(!MerkleTreeVerifyProof(root, TransactionHashedMessage(forged), proof));
+    }
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 4: changing values is reflected in the root
+    BlockChainTransform(blockChain, TimesTwo);
+    MerkleTree rebuilt;
+    MerkleTreeBuild(rebuilt, blockChain);
+    ASSERT_TEST(sameTree(merkle, rebuilt) && MerkleTreeRoot(merkle) != root);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "../BlockChain.h"
+
+//  Shared by every test: each one is a program that stops at the first failed
+//  assertion and prints a line per test that passed.
+
+#define ASSERT_TEST(expr)                                                      \
+do {                                                                           \
+    if (!(expr)) {                                                             \
+        std::cout << "\nAssertion failed at ";                                 \
+        std::cout << __FILE__ << ":" << __LINE__ << ": " << #expr << std::endl;\
+        exit(1);                                                               \
+    }                                                                          \
+} while (0)
+
+
+//Returns the i-th transaction of a made-up ledger over a few accounts
+inline Transaction makeTransaction(const int i)
+{
+    Transaction transaction;
+    transaction.value = i * 7 + 1;
+    transaction.sender = AccountName("sender" + std::to_string(i % 13));
+    transaction.receiver = AccountName("receiver" + std::to_string(i % 5));
+    return transaction;
+}
+
+//Tells whether two chains hold the same transactions and timestamps in the same order
+inline bool sameChain(const BlockChain& first, const BlockChain& second)
+{
+    const BlockChain* left = &first;
+    const BlockChain* right = &second;
+    for (; left != nullptr && right != nullptr; left = left->next, right = right->next) {
+        if (left->timestamp != right->timestamp ||
+            TransactionHashedMessage(left->transaction) !=
+            TransactionHashedMessage(right->transaction)) {
+            return false;
+        }
+    }
+    return left == nullptr && right == nullptr;
+}
+
+//Returns the whole content of a file, empty if it cannot be read
+inline string readFile(const char* path)
+{
+    std::ifstream file(path);
+    return string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
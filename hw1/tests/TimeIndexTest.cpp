@@ -0,0 +1,144 @@
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../BlockChain.h"
+#include "../TimeIndex.h"
+#include "../TransactionLog.h"
+#include "TestUtil.h"
+
+
+static const int BLOCKS = 3000;
+static const int QUERIES = 300;
+static const int NAMES = 6;
+static const char* LOG_PATH = "TimeIndexTest.log";
+
+string randomTime(std::mt19937& random)
+{
+    const int hours = random() % 24;
+    const int minutes = random() % 60;
+    return (hours < 10 ? "0" : "") + std::to_string(hours) + ":" +
+        (minutes < 10 ? "0" : "") + std::to_string(minutes);
+}
+
+//Appends to the indexed chain and to a plain one, which windowed queries scan
+void appendBoth(BlockChain& indexed, BlockChain& scanned, std::mt19937& random,
+    const string& timestamp)
+{
+    const unsigned int value = random() % 1000;
+    const string sender = "n" + std::to_string(random() % NAMES);
+    const string receiver = "n" + std::to_string(random() % NAMES);
+    BlockChainAppendTransaction(indexed, value, sender, receiver, timestamp);
+    BlockChainAppendTransaction(scanned, value, sender, receiver, timestamp);
+}
+
+//Compares windowed balances, dumps and hashes of both chains on random windows
+void sameWindows(BlockChain& indexed, BlockChain& scanned, std::mt19937& random)
+{
+    for (int query = 0; query < QUERIES; query++) {
+        string from = randomTime(random);
+        string to = randomTime(random);
+        if (to < from) {
+            std::swap(from, to);
+        }
+        for (int name = 0; name < NAMES; name++) {
+            const string account = "n" + std::to_string(name);
+            ASSERT_TEST(BlockChainPersonalBalanceWindow(indexed, account, from, to) ==
+                BlockChainPersonalBalanceWindow(scanned, account, from, to));
+        }
+        if (query % 30 == 0) {
+            {
+                ofstream first("TimeIndexTest.1");
+                ofstream second("TimeIndexTest.2");
+                BlockChainDumpWindow(indexed, from, to, first);
+                BlockChainDumpWindow(scanned, from, to, second);
+                BlockChainDumpHashedWindow(indexed, from, to, first);
+                BlockChainDumpHashedWindow(scanned, from, to, second);
+            }
+            ASSERT_TEST(readFile("TimeIndexTest.1") == readFile("TimeIndexTest.2"));
+        }
+    }
+    std::remove("TimeIndexTest.1");
+    std::remove("TimeIndexTest.2");
+}
+
+int main()
+{
+    int test = 0;
+    // Test 1: timestamps are parsed into seconds since midnight
+    ASSERT_TEST(TimeIndexParse("20:40") == 20 * 3600 + 40 * 60);
+    ASSERT_TEST(TimeIndexParse("7:05:09") == 7 * 3600 + 5 * 60 + 9);
+    ASSERT_TEST(TimeIndexParse("24:00") == TimeIndex::INVALID_TIME);
+    ASSERT_TEST(TimeIndexParse("20-40") == TimeIndex::INVALID_TIME);
+    ASSERT_TEST(TimeIndexParse("20:40x") == TimeIndex::INVALID_TIME);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 2: appends in time order keep the index current
+    std::mt19937 random(1729);
+    Ledger indexedLedger;
+    Ledger scannedLedger;
+    TimeIndex times;
+    LedgerAttachTimes(indexedLedger, &times);
+    BlockChain& indexed = LedgerHead(indexedLedger);
+    BlockChain& scanned = LedgerHead(scannedLedger);
+    for (int i = 0; i < BLOCKS; i++) {
+        const int seconds = i * 24 * 3600 / BLOCKS;
+        const string timestamp = std::to_string(seconds / 3600) + ":" +
+            std::to_string(seconds / 60 % 60) + ":" + std::to_string(seconds % 60);
+        appendBoth(indexed, scanned, random, timestamp);
+    }
+    ASSERT_TEST(!times.isStale);
+    sameWindows(indexed, scanned, random);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 3: appends out of time order, and malformed timestamps
+    for (int i = 0; i < BLOCKS; i++) {
+        appendBoth(indexed, scanned, random, i % 50 == 0 ? "noon" : randomTime(random));
+    }
+    sameWindows(indexed, scanned, random);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 4: transform and compress are followed
+    BlockChainTransform(indexed, TimesTwo);
+    BlockChainTransform(scanned, TimesTwo);
+    BlockChainCompress(indexed);
+    BlockChainCompress(scanned);
+    sameWindows(indexed, scanned, random);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 5: a transformed window holds the Blocks the windowed balance sums
+    const int before = BlockChainPersonalBalanceWindow(indexed, "n0", "09:00", "10:00");
+    const int outside = BlockChainPersonalBalanceWindow(indexed, "n0", "10:00", "23:59");
+    BlockChainTransformWindow(indexed, "9:00", "10:00", TimesTwo);
+    ASSERT_TEST(BlockChainPersonalBalanceWindow(indexed, "n0", "09:00", "10:00") == 2 * before);
+    ASSERT_TEST(BlockChainPersonalBalanceWindow(indexed, "n0", "10:00", "23:59") == outside);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 6: windowed queries over a replayed log that goes back in time leave the index alone
+    std::remove(LOG_PATH);
+    {
+        TransactionLog log;
+        ASSERT_TEST(TransactionLogOpen(log, LOG_PATH, 64));
+        for (int i = 0; i < BLOCKS; i++) {
+            ASSERT_TEST(TransactionLogAppend(log, makeTransaction(i), randomTime(random)));
+        }
+        ASSERT_TEST(TransactionLogClose(log));
+    }
+    Ledger replayedLedger;
+    Ledger plainLedger;
+    TimeIndex replayedTimes;
+    LedgerAttachTimes(replayedLedger, &replayedTimes);
+    ASSERT_TEST(TransactionLogReplay(LOG_PATH, LedgerHead(replayedLedger)) == BLOCKS);
+    ASSERT_TEST(TransactionLogReplay(LOG_PATH, LedgerHead(plainLedger)) == BLOCKS);
+    ASSERT_TEST(replayedTimes.isStale);
+    const size_t staleEntries = replayedTimes.entries.size();
+    sameWindows(LedgerHead(replayedLedger), LedgerHead(plainLedger), random);
+    ASSERT_TEST(replayedTimes.isStale && replayedTimes.entries.size() == staleEntries);
+    LedgerAttachTimes(replayedLedger, &replayedTimes);
+    ASSERT_TEST(!replayedTimes.isStale);
+    sameWindows(LedgerHead(replayedLedger), LedgerHead(plainLedger), random);
+    std::remove(LOG_PATH);
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../BlockChain.h"
+#include "../TransactionLog.h"
+#include "TestUtil.h"
+
+
+static const char* LOG_PATH = "TransactionLogTest.log";
+static const int BLOCKS = 100;
+static const int BATCH_SIZE = 8;
+
+long long fileSize(const char* path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return file.tellg();
+}
+
+int main()
+{
+    int test = 0;
+    std::remove(LOG_PATH);
+
+    // Test 1: appends reach the file one whole batch at a time
+    Ledger ledger;
+    TransactionLog log;
+    ASSERT_TEST(TransactionLogOpen(log, LOG_PATH, BATCH_SIZE));
+    LedgerAttachLog(ledger, &log);
+    BlockChain& blockChain = LedgerHead(ledger);
+    const long long emptySize = fileSize(LOG_PATH);
+    for (int i = 0; i < BLOCKS; i++) {
+        BlockChainAppendTransaction(blockChain, makeTransaction(i), "t" + std::to_string(i));
+        ASSERT_TEST((fileSize(LOG_PATH) > emptySize) == (i + 1 >= BATCH_SIZE));
+        ASSERT_TEST(log.pendingCount == (i + 1) % BATCH_SIZE);
+    }
+    ASSERT_TEST(TransactionLogClose(log));
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 2: replaying rebuilds the chain, head-insertion order included
+    Ledger recovered;
+    ASSERT_TEST(TransactionLogReplay(LOG_PATH, LedgerHead(recovered)) == BLOCKS);
+    ASSERT_TEST(sameChain(blockChain, LedgerHead(recovered)));
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 3: reopening appends after the existing records
+    ASSERT_TEST(TransactionLogOpen(log, LOG_PATH, BATCH_SIZE));
+    BlockChainAppendTransaction(blockChain, makeTransaction(BLOCKS), "last");
+    ASSERT_TEST(TransactionLogClose(log));
+    Ledger reopened;
+    ASSERT_TEST(TransactionLogReplay(LOG_PATH, LedgerHead(reopened)) == BLOCKS + 1);
+    ASSERT_TEST(sameChain(blockChain, LedgerHead(reopened)));
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 4: a record torn by a crash is dropped
+    const long long size = fileSize(LOG_PATH);
+    std::ofstream(LOG_PATH, std::ios::binary | std::ios::in | std::ios::out)
+        .seekp(size - 1).put('\x7f');
+    Ledger torn;
+    ASSERT_TEST(TransactionLogReplay(LOG_PATH, LedgerHead(torn)) == BLOCKS);
+    ASSERT_TEST(sameChain(LedgerHead(recovered), LedgerHead(torn)));
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 5: reopening after a torn record cuts it off, so new appends are replayed too
+    ASSERT_TEST(TransactionLogOpen(log, LOG_PATH, BATCH_SIZE));
+    LedgerAttachLog(torn, &log);
+    for (int i = 0; i < 3; i++) {
+        BlockChainAppendTransaction(LedgerHead(torn), makeTransaction(BLOCKS + i), "after");
+    }
+    ASSERT_TEST(TransactionLogClose(log));
+    Ledger resumed;
+    ASSERT_TEST(TransactionLogReplay(LOG_PATH, LedgerHead(resumed)) == BLOCKS + 3);
+    ASSERT_TEST(sameChain(LedgerHead(torn), LedgerHead(resumed)));
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    // Test 6: a file that is not a log is neither replayed nor appended to
+    std::ofstream("TransactionLogTest.txt") << "a b 1 t" << std::endl;
+    Ledger text;
+    ASSERT_TEST(TransactionLogReplay("TransactionLogTest.txt", LedgerHead(text)) == -1);
+    ASSERT_TEST(!TransactionLogOpen(log, "TransactionLogTest.txt", BATCH_SIZE));
+    std::cout << "Test: " << ++test << " Passed" << std::endl;
+
+    std::remove(LOG_PATH);
+    std::remove("TransactionLogTest.txt");
+    return 0;
+}